@@ -83,6 +83,7 @@
 #include <Clustering/include/STK_MixtureLearner.h>
 #include <Clustering/include/STK_MixtureSemiLearner.h>
 #include <Clustering/include/STK_MixtureFacade.h>
+#include <Clustering/include/STK_MixtureScorer.h>
 
 #include <Clustering/include/CategoricalModels/STK_Categorical_pjk.h>
 #include <Clustering/include/CategoricalModels/STK_Categorical_pk.h>
@@ -36,6 +36,8 @@
 #ifndef STK_CATEGORICALBASE_H
 #define STK_CATEGORICALBASE_H
 
+#include <vector>
+
 #include "../STK_IMixtureDensity.h"
 #include "../CategoricalModels/STK_CategoricalParameters.h"
 #include <Arrays/include/STK_Array2DPoint.h>
@@ -63,6 +65,7 @@ class CategoricalBase: public IMixtureDensity<Derived >
      **/
     CategoricalBase( CategoricalBase const& model)
                          : Base(model), modalities_(model.modalities_)
+                         , lnProba_(model.lnProba_)
     {}
     /** destructor */
     ~CategoricalBase() {}
@@ -94,15 +97,26 @@ class CategoricalBase: public IMixtureDensity<Derived >
       modalities_ = _R(amin, amax);
       // resize vectors of probabilities
       param_.resize(modalities_,p_data()->cols());
+      lnProba_.resize(param_.proba_.range());
+      for (int k = lnProba_.begin(); k < lnProba_.end(); ++k)
+      { lnProba_[k].resize(modalities_,p_data()->cols());}
+      parametersChangedImpl();
 #ifdef STK_MIXTURE_VERBOSE
       stk_cout << _T("In CatagoricalBase::initializeModelImpl. modalities_ = ")
                << modalities_ << _T("\n");
 #endif
     }
+    /** Update the cached logarithms of the probabilities. */
+    void parametersChangedImpl();
     /** @return the value of the probability of the i-th sample in the k-th component.
      *  @param i,k indexes of the sample and of the component
      **/
     Real lnComponentProbability(int i, int k) const;
+    /** Add the log-probabilities of a block of samples to lnComp.
+     *  @param rows range of the samples
+     *  @param lnComp array of size (rows, nbCluster) to update
+     **/
+    void lnComponentProbabilities(Range const& rows, CArrayXX& lnComp) const;
     /** @return an imputation value for the jth variable of the ith sample
      *  @param i,j indexes of the data to impute
      *  @param tk the probabilities of each class for the ith individual
@@ -131,23 +145,99 @@ class CategoricalBase: public IMixtureDensity<Derived >
     PointXi nbModalities_;
     /** range of the modalities */
     Range modalities_;
+    /** logarithms of the probabilities: lnProba_[k](l,j) = log(proba(k,j,l)).
+     *  A null probability is stored as zero and thus ignored. */
+    Array1D<CArrayXX> lnProba_;
+
+    /** Count in a single pass over the data the occurrences of the modalities
+     *  weighted by the posterior probabilities. The count of the modality l of
+     *  the variable j in the cluster k is stored in counts(r,k) with
+     *  r = (j - first column) * number of modalities + (l - first modality).
+     *  @param p_tik the posterior probabilities
+     *  @param[out] counts the weighted counts
+     **/
+    void countModalities( CArrayXX const* p_tik, CArrayByRowXX& counts) const;
 };
 
+/* Update the cached logarithms of the probabilities */
+template<class Derived>
+void CategoricalBase<Derived>::parametersChangedImpl()
+{
+  for (int k = lnProba_.begin(); k < lnProba_.end(); ++k)
+  {
+    for (int j = lnProba_[k].beginCols(); j < lnProba_[k].endCols(); ++j)
+    {
+      for (int l = modalities_.begin(); l < modalities_.end(); ++l)
+      {
+        Real prob = proba(k, j, l);
+        lnProba_[k](l, j) = (prob) ? std::log(prob) : 0.;
+      }
+    }
+  }
+}
+
 /* @return the value of the probability of the i-th sample in the k-th component.
  *  @param i,k indexes of the sample and of the component
  **/
 template<class Derived>
 inline Real CategoricalBase<Derived>::lnComponentProbability(int i, int k) const
 {
+  // what to do if the probability is zero but a sample get this modality
+  // for now, just ignore it (it's possible if tik_(i,k) == 0)
   Real sum =0.;
   for (int j=p_data()->beginCols(); j<p_data()->endCols(); ++j)
-  { // what to do if the probability is zero but a sample get this modality
-    // for now, just ignore it (it's possible if tik_(i,k) == 0)
-    Real prob= proba(k, j, p_data()->elt(i,j));
-    if (prob) { sum += std::log(prob);}
-   }
+  { sum += lnProba_[k](p_data()->elt(i,j), j);}
   return sum;
 }
+/* Add the log-probabilities of a block of samples to lnComp. */
+template<class Derived>
+void CategoricalBase<Derived>::lnComponentProbabilities(Range const& rows, CArrayXX& lnComp) const
+{
+  for (int k= lnComp.beginCols(); k < lnComp.endCols(); ++k)
+  {
+    CArrayXX const& lnProba = lnProba_[k];
+    for (int j=p_data()->beginCols(); j<p_data()->endCols(); ++j)
+    {
+      for (int i= rows.begin(); i < rows.end(); ++i)
+      { lnComp(i,k) += lnProba(p_data()->elt(i,j), j);}
+    }
+  }
+}
+
+/* Count the modalities weighted by the posterior probabilities */
+template<class Derived>
+void CategoricalBase<Derived>::countModalities( CArrayXX const* p_tik, CArrayByRowXX& counts) const
+{
+  const int nbModality = modalities_.size(), nbRow = p_tik->sizeRows();
+  const int nbChunk = std::max(1, std::min(Clust::mStepMaxChunk_, nbRow/Clust::eStepBlockSize_));
+  counts.resize(p_data()->sizeCols() * nbModality, p_tik->cols());
+  std::vector<CArrayByRowXX> partial(nbChunk);
+  int c;
+#ifdef _OPENMP
+#pragma omp parallel for if (nbChunk > 1)
+#endif
+  for (c = 0; c < nbChunk; ++c)
+  {
+    CArrayByRowXX& table = partial[c];
+    table.resize(counts.rows(), counts.cols());
+    table = 0.;
+    CPointX tk(p_tik->cols());
+    const int begin = p_tik->beginRows() + (c * nbRow)/nbChunk;
+    const int end   = p_tik->beginRows() + ((c+1) * nbRow)/nbChunk;
+    for (int i = begin; i < end; ++i)
+    {
+      tk = p_tik->row(i);
+      int r = table.beginRows() - modalities_.begin();
+      for (int j = p_data()->beginCols(); j < p_data()->endCols(); ++j, r += nbModality)
+      {
+        const int rij = r + p_data()->elt(i,j);
+        for (int k = tk.begin(); k < tk.end(); ++k) { table(rij, k) += tk[k];}
+      }
+    }
+  }
+  counts = partial[0];
+  for (c = 1; c < nbChunk; ++c) { counts += partial[c];}
+}
 
 /* Implementation  */
 template<class Derived>
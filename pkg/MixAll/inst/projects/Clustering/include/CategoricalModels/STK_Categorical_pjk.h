@@ -111,14 +111,16 @@ void Categorical_pjk<Array>::randomInit( CArrayXX const* const& p_tik, CPointX c
 template<class Array>
 bool Categorical_pjk<Array>::run( CArrayXX const* const& p_tik, CPointX const* const& p_tk)
 {
+  // count the number of modalities weighted by the tik in a single pass
+  CArrayByRowXX counts;
+  this->countModalities(p_tik, counts);
   for (int k = p_tik->beginCols(); k < p_tik->endCols(); ++k)
   {
-    param_.proba_[k] = 0.;
+    int r = counts.beginRows();
     for (int j = p_data()->beginCols(); j < p_data()->endCols(); ++j)
     {
-      // count the number of modalities weighted by the tik
-      for (int i = p_data()->beginRows(); i < p_data()->endRows(); ++i)
-      { param_.proba_[k](p_data()->elt(i, j), j) += p_tik->elt(i, k);}
+      for (int l = modalities_.begin(); l < modalities_.end(); ++l, ++r)
+      { param_.proba_[k](l, j) = counts(r, k);}
       // normalize the probabilities
       Real sum = param_.proba_[k].col(j).sum();
       if (sum) { param_.proba_[k].col(j) /= sum;}
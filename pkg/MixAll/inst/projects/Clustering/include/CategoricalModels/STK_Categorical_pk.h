@@ -108,17 +108,21 @@ void Categorical_pk<Array>::randomInit( CArrayXX const* const& p_tik, CPointX co
   }
 }
 
-/* Compute the weighted mean and the common variance. */
+/* Compute the modalities probabilities */
 template<class Array>
 bool Categorical_pk<Array>::run( CArrayXX const* const& p_tik, CPointX const* const& p_tk)
 {
+  // count the number of modalities weighted by the tik in a single pass
+  CArrayByRowXX counts;
+  this->countModalities(p_tik, counts);
   for (int k = p_tik->beginCols(); k < p_tik->endCols(); ++k)
   {
     param_.proba_[k] = 0.;
+    int r = counts.beginRows();
     for (int j = p_data()->beginCols(); j < p_data()->endCols(); ++j)
     {
-      for (int i = p_tik->beginRows(); i < p_tik->endRows(); ++i)
-      { param_.proba_[k][(*p_data())(i, j)] += (*p_tik)(i, k);}
+      for (int l = modalities_.begin(); l < modalities_.end(); ++l, ++r)
+      { param_.proba_[k][l] += counts(r, k);}
     }
     Real sum = param_.proba_[k].sum();
     if (sum<=0.) return false;
@@ -36,9 +36,11 @@
 #define STK_DIAGGAUSSIANBASE_H
 
 #include "../STK_IMixtureDensity.h"
+#include "../STK_MixtureStatistics.h"
 
 #include <Arrays/include/STK_Const_Arrays.h>
 #include <Arrays/include/STK_Display.h>
+#include <Analysis/include/STK_Const_Math.h>
 #include <STatistiK/include/STK_Law_Normal.h>
 #include <STatistiK/include/STK_Law_UniformDiscrete.h>
 #include "../DiagGaussianModels/STK_DiagGaussianParameters.h"
@@ -83,6 +85,11 @@ class DiagGaussianBase: public IMixtureDensity<Derived >
      *  @param i,k indexes of the sample and of the component
      **/
     Real lnComponentProbability(int i, int k) const;
+    /** Add the log-probabilities of a block of samples to lnComp.
+     *  @param rows range of the samples
+     *  @param lnComp array of size (rows, nbCluster) to update
+     **/
+    void lnComponentProbabilities(Range const& rows, CArrayXX& lnComp) const;
     /** @return an imputation value for the jth variable of the ith sample
      *  @param i,j indexes of the data to impute
      *  @param pk the probabilities of each class for the ith individual
@@ -113,6 +120,11 @@ class DiagGaussianBase: public IMixtureDensity<Derived >
     void randomMean( CArrayXX const*  p_tik);
     /** compute the weighted mean of a Gaussian mixture. */
     bool updateMean( CArrayXX const*  p_tik);
+    /** compute the weighted mean and the weighted variances of a Gaussian mixture.
+     *  @param p_tik the posterior probabilities
+     *  @param[out] variance the weighted variances of each component (K x d)
+     **/
+    bool updateMoments( CArrayXX const*  p_tik, CArrayXX& variance);
 };
 
 /* @return the value of the log-probability of the i-th sample in the k-th
@@ -131,6 +143,32 @@ Real DiagGaussianBase<Derived>::lnComponentProbability(int i, int k) const
   return sum;
 }
 
+/* Add the log-probabilities of a block of samples to lnComp.
+ * The computation is done column by column in order to compute only once the
+ * constant terms of each component.
+ **/
+template<class Derived>
+void DiagGaussianBase<Derived>::lnComponentProbabilities(Range const& rows, CArrayXX& lnComp) const
+{
+  for (int k= lnComp.beginCols(); k < lnComp.endCols(); ++k)
+  {
+    for (int j=p_data()->beginCols(); j<p_data()->endCols(); ++j)
+    {
+      Real s = sigma(k,j);
+      if (s)
+      {
+        Real m = mean(k,j), invs = 1./s;
+        Real cst = -(Const::_LNSQRT2PI_ + std::log(s));
+        for (int i= rows.begin(); i < rows.end(); ++i)
+        {
+          Real z = (p_data()->elt(i,j) - m) * invs;
+          lnComp(i,k) += cst - 0.5 * z * z;
+        }
+      }
+    }
+  }
+}
+
 /* @return an imputation value for the jth variable of the ith sample
  *  @param i,j indexes of the data to impute
  *  @param pk the probabilities of each class for the ith individual
@@ -170,11 +208,21 @@ void DiagGaussianBase<Derived>::randomMean( CArrayXX const*  p_tik)
 template<class Derived>
 bool DiagGaussianBase<Derived>::updateMean( CArrayXX const*  p_tik)
 {
+  CArrayXX mean;
+  Clust::weightedMeans(*p_data(), *p_tik, mean);
   for (int k= p_tik->beginCols(); k < p_tik->endCols(); ++k)
-  {
-    for (int j=p_data()->beginCols(); j< p_data()->endCols(); ++j)
-    { param_.mean_[k][j] = p_data()->col(j).wmean(p_tik->col(k));}
-  }
+  { param_.mean_[k] = mean.row(k);}
+  return true;
+}
+
+/* compute the weighted mean and the weighted variances of a Gaussian mixture. */
+template<class Derived>
+bool DiagGaussianBase<Derived>::updateMoments( CArrayXX const*  p_tik, CArrayXX& variance)
+{
+  CArrayXX mean;
+  Clust::weightedMoments(*p_data(), *p_tik, mean, variance);
+  for (int k= p_tik->beginCols(); k < p_tik->endCols(); ++k)
+  { param_.mean_[k] = mean.row(k);}
   return true;
 }
 
@@ -121,17 +121,13 @@ void DiagGaussian_s<Array>::randomInit( CArrayXX const* const& p_tik, CPointX co
 template<class Array>
 bool DiagGaussian_s<Array>::run( CArrayXX const* const& p_tik, CPointX const* const& p_tk)
 {
-  // compute the means
-  if (!this->updateMean(p_tik)) return false;
+  // compute the means and the variances
+  CArrayXX variancek;
+  if (!this->updateMoments(p_tik, variancek)) return false;
   // compute the standard deviation
   Real variance = 0.0;
   for (int k= p_tik->beginCols(); k < p_tik->endCols(); ++k)
-  {
-    variance += ( p_tik->col(k).transpose()
-                 * (*p_data() - (Const::Vector<Real>(this->nbSample()) * param_.mean_[k])
-                   ).square()
-                ).sum();
-  }
+  { variance += p_tk->elt(k) * variancek.row(k).sum();}
   param_.sigma_ = std::sqrt(variance/(this->nbSample()*p_data()->sizeCols()));
 #ifdef STK_MIXTURE_DEBUG
     if( param_.sigma_ <= 0  )
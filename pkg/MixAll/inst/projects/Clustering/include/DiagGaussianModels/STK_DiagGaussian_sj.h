@@ -126,17 +126,13 @@ void DiagGaussian_sj<Array>::randomInit( CArrayXX const* const& p_tik, CPointX c
 template<class Array>
 bool DiagGaussian_sj<Array>::run( CArrayXX const* const& p_tik, CPointX const* const& p_tk) 
 {
-  // compute the means
-  if (!this->updateMean(p_tik)) return false;
+  // compute the means and the variances
+  CArrayXX variancek;
+  if (!this->updateMoments(p_tik, variancek)) return false;
   // compute the standard deviation
   Array2DPoint<Real> variance(p_data()->cols(), 0.);
   for (int k= p_tik->beginCols(); k < p_tik->endCols(); ++k)
-  {
-    variance += p_tik->col(k).transpose()
-               *(*p_data() - (Const::Vector<Real>(this->nbSample()) * param_.mean_[k])
-                ).square()
-                ;
-  }
+  { variance += p_tk->elt(k) * variancek.row(k);}
 //  if (variance.nbAvailableValues() != p_data()->sizeCols()) return false;
 //  if ((variance > 0.).template cast<int>().sum() != p_data()->sizeCols()) return false;
   // compute the standard deviation
@@ -129,12 +129,13 @@ void DiagGaussian_sjsk<Array>::randomInit( CArrayXX const* const& p_tik, CPointX
 template<class Array>
 bool DiagGaussian_sjsk<Array>::run( CArrayXX const* const& p_tik, CPointX const* const& p_tk)
 {
-  // compute the means
-  if (!this->updateMean(p_tik)) return false;
+  // compute the means and the variances
+  CArrayXX variance;
+  if (!this->updateMoments(p_tik, variance)) return false;
   // compute the standard deviation
   for (int k= p_tik->beginCols(); k < p_tik->endCols(); ++k)
   {
-    param_.sigma_[k] = Stat::varianceWithFixedMean(*p_data(), p_tik->col(k), param_.mean_[k], false).sqrt();
+    param_.sigma_[k] = variance.row(k).sqrt();
 #ifdef STK_MIXTURE_DEBUG
     if( (param_.sigma_[k] <= 0).any()  )
     {
@@ -125,18 +125,13 @@ void DiagGaussian_sk<Array>::randomInit( CArrayXX const* const& p_tik, CPointX c
 template<class Array>
 bool DiagGaussian_sk<Array>::run( CArrayXX const* const& p_tik, CPointX const* const& p_tk) 
 {
-  // compute the means
-  if (!this->updateMean(p_tik)) return false;
+  // compute the means and the variances
+  CArrayXX variance;
+  if (!this->updateMoments(p_tik, variance)) return false;
   // compute the standard deviation
   for (int k= p_tik->beginCols(); k < p_tik->endCols(); ++k)
   {
-    param_.sigma_[k]
-    = sqrt( ( p_tik->col(k).transpose()
-             *(*p_data() - (Const::Vector<Real>(this->nbSample()) * param_.mean_[k])
-              ).square()
-            ).sum()
-           /(p_data()->sizeCols()*p_tk->elt(k))
-          );
+    param_.sigma_[k] = std::sqrt( variance.row(k).sum()/p_data()->sizeCols());
 //    if (param(k).sigma_ <= 0.) return false;
   }
   return true;
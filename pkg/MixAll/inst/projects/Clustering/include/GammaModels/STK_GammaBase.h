@@ -44,6 +44,7 @@
 #include <Analysis/include/STK_Funct_raw.h>
 #include <Analysis/include/STK_Funct_gamma.h>
 #include "../GammaModels/STK_GammaParameters.h"
+#include "../STK_MixtureStatistics.h"
 
 namespace STK
 {
@@ -103,11 +104,16 @@ class GammaBase: public IMixtureDensity<Derived >
     /** default constructor
      * @param nbCluster number of cluster in the model
      **/
-    GammaBase( int nbCluster): Base(nbCluster) {}
+    GammaBase( int nbCluster): Base(nbCluster), lnData_(), lnCst_(), invScale_() {}
     /** copy constructor
      *  @param model The model to copy
      **/
-    GammaBase( GammaBase const& model): Base(model) {}
+    GammaBase( GammaBase const& model)
+             : Base(model)
+             , lnData_(model.lnData_)
+             , lnCst_(model.lnCst_)
+             , invScale_(model.invScale_)
+    {}
     /** destructor */
     ~GammaBase() {}
 
@@ -117,13 +123,23 @@ class GammaBase: public IMixtureDensity<Derived >
     /** @return the scale of the kth cluster and jth variable */
     inline Real scale(int k, int j) const { return param_.scale(k,j);}
 
-    /** Initialize the parameters of the model. */
-    void initializeModelImpl() { param_.resize(p_data()->cols());}
+    /** Initialize the parameters of the model and the cached values. */
+    void initializeModelImpl();
+    /** Update the constant terms of the log-densities */
+    void parametersChangedImpl();
+    /** Update the logarithm of the (i,j) imputed or simulated value */
+    inline void dataChangedImpl(int i, int j)
+    { lnData_(i,j) = std::log(p_data()->elt(i,j));}
 
     /** @return the value of the probability of the i-th sample in the k-th component.
      *  @param i,k indexes of the sample and of the component
      **/
     Real lnComponentProbability(int i, int k) const;
+    /** Add the log-probabilities of a block of samples to lnComp.
+     *  @param rows range of the samples
+     *  @param lnComp array of size (rows, nbCluster) to update
+     **/
+    void lnComponentProbabilities(Range const& rows, CArrayXX& lnComp) const;
     /** @return an imputation value for the jth variable of the ith sample
      *  @param i,j indexes of the data to impute
      *  @param pk the probabilities of each class for the ith individual
@@ -161,8 +177,46 @@ class GammaBase: public IMixtureDensity<Derived >
     inline Real meank( int k) { return param_.mean_[k].mean();}
     /** get the mean of the weighted variances of the kth cluster. */
     inline Real variancek( int k) { return param_.variance_[k].mean();}
+
+  private:
+    /** logarithm of the data set */
+    CArrayXX lnData_;
+    /** constant terms \f$ -\log\Gamma(a_{jk}) - a_{jk}\log(b_{jk}) \f$ of the log-densities */
+    CArrayXX lnCst_;
+    /** inverse of the scales */
+    CArrayXX invScale_;
 };
 
+/* Initialize the parameters of the model and the cached values. */
+template<class Derived>
+void GammaBase<Derived>::initializeModelImpl()
+{
+  param_.resize(p_data()->cols());
+  lnData_.resize(p_data()->rows(), p_data()->cols());
+  lnData_ = p_data()->log();
+  lnCst_.resize(this->nbCluster(), p_data()->cols());
+  invScale_.resize(this->nbCluster(), p_data()->cols());
+  parametersChangedImpl();
+}
+
+/* Update the constant terms of the log-densities */
+template<class Derived>
+void GammaBase<Derived>::parametersChangedImpl()
+{
+  for (int k= lnCst_.beginRows(); k < lnCst_.endRows(); ++k)
+  {
+    for (int j=lnCst_.beginCols(); j<lnCst_.endCols(); ++j)
+    {
+      Real a = shape(k,j), b = scale(k,j);
+      if (a && b)
+      {
+        lnCst_(k,j)    = -Funct::lgamma(a) - a * std::log(b);
+        invScale_(k,j) = 1./b;
+      }
+    }
+  }
+}
+
 /** @return the value of the probability of the i-th sample in the k-th component.
  *  @param i,k indexes of the sample and of the component
  **/
@@ -172,11 +226,41 @@ Real GammaBase<Derived>::lnComponentProbability(int i, int k) const
   Real sum =0.;
   for (int j=p_data()->beginCols(); j<p_data()->endCols(); ++j)
   {
-    if (param_.shape(k,j) && param_.scale(k,j))
-    { sum += Law::Gamma::lpdf(p_data()->elt(i,j), param_.shape(k,j), param_.scale(k,j));}
+    Real a = shape(k,j), b = scale(k,j);
+    if (a && b)
+    {
+      Real x = p_data()->elt(i,j);
+      sum += (x > 0.) ? (a - 1.) * lnData_(i,j) - x * invScale_(k,j) + lnCst_(k,j)
+                      : Law::Gamma::lpdf(x, a, b);
+    }
   }
   return sum;
 }
+/* Add the log-probabilities of a block of samples to lnComp using the
+ * cached logarithm of the data and the cached constant terms.
+ **/
+template<class Derived>
+void GammaBase<Derived>::lnComponentProbabilities(Range const& rows, CArrayXX& lnComp) const
+{
+  for (int k= lnComp.beginCols(); k < lnComp.endCols(); ++k)
+  {
+    for (int j=p_data()->beginCols(); j<p_data()->endCols(); ++j)
+    {
+      Real a = shape(k,j), b = scale(k,j);
+      if (a && b)
+      {
+        Real am1 = a - 1., invb = invScale_(k,j), cst = lnCst_(k,j);
+        for (int i= rows.begin(); i < rows.end(); ++i)
+        {
+          Real x = p_data()->elt(i,j);
+          lnComp(i,k) += (x > 0.) ? am1 * lnData_(i,j) - x * invb + cst
+                                  : Law::Gamma::lpdf(x, a, b);
+        }
+      }
+    }
+  }
+}
+
 /* @return an imputation value for the jth variable of the ith sample
  *  @param i,j indexes of the data to impute
  *  @param pk the probabilities of each class for the ith individual
@@ -195,23 +279,22 @@ Real GammaBase<Derived>::impute(int i, int j, Weights const& pk) const
 template<class Derived>
 bool GammaBase<Derived>::moments(CArrayXX const* p_tik)
 {
+  CArrayXX mean, meanLog, variance;
+  Clust::weightedMoments(*p_data(), *p_tik, mean, variance);
+  Clust::weightedMeans(lnData_, *p_tik, meanLog);
   for (int k= p_tik->beginCols(); k < p_tik->endCols(); ++k)
   {
-    CVectorX tikColk(p_tik->col(k), true); // create a reference
     for (int j=p_data()->beginCols(); j<p_data()->endCols(); ++j)
     {
       // mean
-      Real mean =  p_data()->col(j).wmean(tikColk);
-      if ( (mean<=0) || isNA(mean) ) { return false;}
-      param_.mean_[k][j] = mean;
+      if ( (mean(k,j)<=0) || isNA(mean(k,j)) ) { return false;}
+      param_.mean_[k][j] = mean(k,j);
       // mean log
-      Real meanLog =  p_data()->col(j).log().wmean(tikColk);
-      if (isNA(meanLog)) { return false;}
-      param_.meanLog_[k][j] = meanLog;
+      if (isNA(meanLog(k,j))) { return false;}
+      param_.meanLog_[k][j] = meanLog(k,j);
       // variance
-      Real variance =  p_data()->col(j).wvariance(mean, tikColk);
-      if ((variance<=0)||isNA(variance)){ return false;}
-      param_.variance_[k][j] = variance;
+      if ((variance(k,j)<=0)||isNA(variance(k,j))){ return false;}
+      param_.variance_[k][j] = variance(k,j);
     }
   }
   return true;
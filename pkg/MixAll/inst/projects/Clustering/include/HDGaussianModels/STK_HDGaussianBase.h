@@ -36,6 +36,7 @@
 #define STK_HDGAUSSIANBASE_H
 
 #include "../STK_IMixtureDensity.h"
+#include "../STK_MixtureStatistics.h"
 #include <Arrays/include/STK_CArray.h>
 #include <Arrays/include/STK_CArrayPoint.h>
 #include <Arrays/include/STK_CArrayVector.h>
@@ -116,6 +117,11 @@ class HDGaussianBase: public IMixtureDensity<Derived >
     void randomMean( CArrayXX const*  p_tik);
     /** compute the weighted mean of a Gaussian mixture. */
     bool updateMean( CArrayXX const*  p_tik);
+    /** compute the weighted mean and the weighted variances of a Gaussian mixture.
+     *  @param p_tik the posterior probabilities
+     *  @param[out] variance the weighted variances of each component (K x d)
+     **/
+    bool updateMoments( CArrayXX const*  p_tik, CArrayXX& variance);
 };
 
 template<class Derived>
@@ -152,11 +158,21 @@ void HDGaussianBase<Derived>::randomMean( CArrayXX const*  p_tik)
 template<class Derived>
 bool HDGaussianBase<Derived>::updateMean( CArrayXX const*  p_tik)
 {
+  CArrayXX mean;
+  Clust::weightedMeans(*p_data(), *p_tik, mean);
   for (int k= p_tik->beginCols(); k < p_tik->endCols(); ++k)
-  {
-    for (int j=p_data()->beginCols(); j< p_data()->endCols(); ++j)
-    { param_.mean_[k][j] = p_data()->col(j).wmean(p_tik->col(k));}
-  }
+  { param_.mean_[k] = mean.row(k);}
+  return true;
+}
+
+/* compute the weighted mean and the weighted variances of a Gaussian mixture. */
+template<class Derived>
+bool HDGaussianBase<Derived>::updateMoments( CArrayXX const*  p_tik, CArrayXX& variance)
+{
+  CArrayXX mean;
+  Clust::weightedMoments(*p_data(), *p_tik, mean, variance);
+  for (int k= p_tik->beginCols(); k < p_tik->endCols(); ++k)
+  { param_.mean_[k] = mean.row(k);}
   return true;
 }
 
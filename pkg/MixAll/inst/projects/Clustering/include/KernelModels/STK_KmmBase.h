@@ -35,6 +35,8 @@
 #ifndef STK_KMMBASE_H
 #define STK_KMMBASE_H
 
+#include <vector>
+
 #include "../STK_IMixtureDensity.h"
 
 #include <Arrays/include/STK_CArray.h>
@@ -43,6 +45,10 @@
 #include <STatistiK/include/STK_Kernel_IKernel.h>
 #include "STK_KernelParameters.h"
 
+#ifdef _OPENMP
+#include <omp.h>
+#endif
+
 namespace STK
 {
 
@@ -150,9 +156,24 @@ class KmmBase: public IMixtureDensity<Derived>
     void initializeModel();
     /** compute the distance of the ith individual to the kth centroid
      *  \f[ d_{ik} = \|\phi(x_i)-m_k\| \f]
-     *  using the kernel trick.
+     *  using the kernel trick, or the low rank feature map of the kernel if
+     *  it is available.
      **/
     void compute_dik(CArrayXX const* p_tik, CPointX const* p_tk);
+    /** compute the distance of the ith individual to the kth centroid using
+     *  the low rank feature map \f$ \Phi \f$ of the kernel. The centroids
+     *  \f$ m_k = \Phi^T t_{.k}/t_{.k} \f$ are computed explicitly, thus the
+     *  cost is O(n m K) rather than O(n^2 K).
+     **/
+    void compute_dikFeatures(CArrayXX const* p_tik, CPointX const* p_tk);
+    /** compute the products \f$ w_{ik} = \sum_{j=1}^n k(x_i,x_j) t_{jk} \f$
+     *  for all the clusters in a single pass when the gram matrix is not
+     *  stored. Each value of the kernel is computed once using its symmetry
+     *  and the rows are shared between the threads.
+     *  @param p_tik the posterior probabilities
+     *  @param wik the array of size (n, K) to compute
+     **/
+    void computeKernelProduct(CArrayXX const* p_tik, CArrayXX& wik) const;
     /** default implementation of initializeModelImpl (do nothing) */
     inline void initializeModelImpl() {/* do nothing*/}
 
@@ -176,27 +197,98 @@ void KmmBase<Derived>::compute_dik(CArrayXX const* p_tik, CPointX const* p_tk)
   stk_cout << _T("dik_.cols() =") << dik_.cols() << _T("\n");
   stk_cout << _T("dik_.rows() =") << dik_.rows() << _T("\n");
 #endif
-  CVectorX wik(dik_.rows());
+  if (p_kernel_->hasFeatures())
+  {
+    compute_dikFeatures(p_tik, p_tk);
+    return;
+  }
+  // Compute wik=\sum_{j=1}^n k(x_i,x_j) t_{jk}, for k=1,..,K
+  CArrayXX wik;
+  if (p_kernel_->hasGram()) { wik = p_kernel_->gram() * (*p_tik);}
+  else                      { computeKernelProduct(p_tik, wik);}
   for (int k=dik_.beginCols(); k<dik_.endCols(); ++k)
   {
-    // Compute wik=\sum_{j=1}^n k(x_i,x_j) t_{jk}/t_{.k}, for k=1,..,K
-    for (int i= wik.begin(); i < wik.end(); ++i)
-    {
-      wik[i] = 0.;
-      for (int j= wik.begin(); j < wik.end(); ++j)
-      { wik[i] += p_kernel_->comp(i, j) * p_tik->elt(j,k);}
-    }
-    wik /= p_tk->elt(k);
+    // an empty cluster has a null centroid
+    Real tk = p_tk->elt(k);
+    if (tk > 0.) { wik.col(k) /= tk;} else { wik.col(k) = 0.;}
     // compute dik_ = k(i,i) - 2 * wik + \sum_{i=1}^n t_{ik} w_{ik}/t_{.k}
-    Real dk = p_tik->col(k).dot(wik)/p_tk->elt(k);
-    for (int i= wik.begin(); i<wik.end(); ++i)
-    { dik_(i,k) = p_kernel_->diag(i) - 2. * wik[i] + dk  ;}
+    Real dk = (tk > 0.) ? p_tik->col(k).dot(wik.col(k))/tk : 0.;
+    for (int i= dik_.beginRows(); i<dik_.endRows(); ++i)
+    { dik_(i,k) = p_kernel_->diag(i) - 2. * wik(i,k) + dk  ;}
   }
 #ifdef STK_KERNELS_DEBUG
   stk_cout << _T("KmmBase::compute_dik done\n");
 #endif
 }
 
+/* compute the products wik = \sum_{j=1}^n k(x_i,x_j) t_{jk} without gram matrix.
+ * Each thread accumulates in its own array (static cyclic distribution of the
+ * rows, so that the triangular workload is balanced and the result does not
+ * depend on the scheduling), the arrays are then added in thread order.
+ **/
+template<class Derived>
+void KmmBase<Derived>::computeKernelProduct(CArrayXX const* p_tik, CArrayXX& wik) const
+{
+  Range rows = p_tik->rows(), cols = p_tik->cols();
+#ifdef _OPENMP
+  int nbThread = omp_get_max_threads();
+#else
+  int nbThread = 1;
+#endif
+  std::vector<CArrayXX> v_wik(nbThread, CArrayXX(rows, cols, 0.));
+#ifdef _OPENMP
+#pragma omp parallel for schedule(static,1)
+#endif
+  for (int i= rows.begin(); i < rows.end(); ++i)
+  {
+#ifdef _OPENMP
+    CArrayXX& acc = v_wik[omp_get_thread_num()];
+#else
+    CArrayXX& acc = v_wik[0];
+#endif
+    Real kii = p_kernel_->diag(i);
+    for (int k= cols.begin(); k < cols.end(); ++k) { acc(i,k) += kii * p_tik->elt(i,k);}
+    for (int j= i+1; j < rows.end(); ++j)
+    {
+      Real kij = p_kernel_->comp(i, j);
+      for (int k= cols.begin(); k < cols.end(); ++k)
+      {
+        acc(i,k) += kij * p_tik->elt(j,k);
+        acc(j,k) += kij * p_tik->elt(i,k);
+      }
+    }
+  }
+  wik = v_wik[0];
+  for (int t= 1; t < nbThread; ++t) { wik += v_wik[t];}
+}
+
+/* compute the distances to the centroids using the low rank feature map */
+template<class Derived>
+void KmmBase<Derived>::compute_dikFeatures(CArrayXX const* p_tik, CPointX const* p_tk)
+{
+  CArrayXX const& phi = p_kernel_->features();
+  // centroids m_k = \sum_{j=1}^n t_{jk} \phi(x_j)/t_{.k}, for k=1,..,K
+  CArrayXX mk = p_tik->transpose() * phi;
+  for (int k=dik_.beginCols(); k<dik_.endCols(); ++k)
+  {
+    // an empty cluster has a null centroid
+    Real tk = p_tk->elt(k);
+    if (tk > 0.) { mk.row(k) /= tk;} else { mk.row(k) = 0.;}
+  }
+  // wik = <\phi(x_i), m_k>
+  CArrayXX wik = phi * mk.transpose();
+  // \|\phi(x_i)\|^2 rather than k(x_i,x_i), so that all the terms use the
+  // same approximation of the kernel
+  CVectorX const& phiNorm2 = p_kernel_->featuresNorm2();
+  for (int k=dik_.beginCols(); k<dik_.endCols(); ++k)
+  {
+    // compute dik_ = \|\phi(x_i)\|^2 - 2 * wik + \|m_k\|^2
+    Real dk = mk.row(k).norm2();
+    for (int i= dik_.beginRows(); i<dik_.endRows(); ++i)
+    { dik_(i,k) = phiNorm2[i] - 2. * wik(i,k) + dk;}
+  }
+}
+
 /* @brief Initialize the model before its first use.
  * This function is triggered when data set is set.
  * In this interface, the @c initializeModel() method
@@ -63,6 +63,8 @@ class IMixtureAlgo: public IRunnerBase
   public:
     /** destructor */
     virtual ~IMixtureAlgo();
+    /** clone pattern */
+    virtual IMixtureAlgo* clone() const = 0;
 
     // getters
     /** @return the maximal number of iteration of the algorithm */
@@ -112,7 +112,11 @@ class IMixtureAlgoPredict: public IRunnerBase
      * @endcode
      * @return @c true if no error occur, @c false otherwise */
     bool burnStep();
-
+    /** Initialize the model using its initializeStep() method. The
+     *  proportions of the model are kept, as initializeStep() set them to
+     *  1/K and the prediction has to use the estimated proportions.
+     **/
+    void initializeModel();
 };
 
 } // namespace STK
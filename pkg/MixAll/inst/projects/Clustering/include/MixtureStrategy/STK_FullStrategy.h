@@ -50,6 +50,7 @@ class IMixtureAlgo;
 struct FullStrategyParam
 {  /** Constructor. Set default values */
     inline FullStrategyParam() : nbInitRun_(1), nbShortRun_(0), p_shortAlgo_(0) , p_longAlgo_(0)
+                               , parallelShortRun_(true)
     {}
     /** destructor */
     virtual ~FullStrategyParam();
@@ -61,6 +62,8 @@ struct FullStrategyParam
     IMixtureAlgo* p_shortAlgo_;
     /** algorithm to use in long run  */
     IMixtureAlgo* p_longAlgo_;
+    /** @c true if the short runs can be performed in parallel (default) */
+    bool parallelShortRun_;
 };
 
 /** @ingroup Clustering
@@ -71,6 +74,14 @@ struct FullStrategyParam
  *  - pick the best model obtained,
  *  - on this best model perform a long run.
  *  This strategy is used in Rmixmod R package.
+ *
+ *  When OpenMP is available, the short runs are dispatched to the threads,
+ *  each one working on its own model. The initializations are still performed
+ *  sequentially as they use the shared random generator, so that the results
+ *  do not depend on the number of threads. The short runs are performed in
+ *  parallel only if the short algorithm is not stochastic and if there is no
+ *  missing values (the imputed values are stored in the data sets shared by
+ *  the models), otherwise they are performed sequentially.
  **/
 class FullStrategy: public IMixtureStrategy
 {
@@ -104,6 +115,26 @@ class FullStrategy: public IMixtureStrategy
      *  @param p_bestModel a pointer initialized to
      **/
     bool initStep(IMixtureComposer*& p_bestModel);
+    /** Initialize nbInitRun_ models and select the best model among them.
+     *  @param p_bestModel a pointer on the best model found
+     *  @return @c false if an exception occurred, @c true otherwise
+     **/
+    bool initRuns(IMixtureComposer*& p_bestModel);
+    /** Run the short algorithm on a model.
+     *  @param p_algo the short algorithm to use
+     *  @param p_model the model to estimate
+     *  @param msg the string receiving the error message if any
+     *  @return @c false if an exception occurred, @c true otherwise
+     **/
+    bool shortRun(IMixtureAlgo* p_algo, IMixtureComposer* p_model, String& msg) const;
+    /** @return @c true if the short runs can be performed in parallel */
+    bool isParallelShortRun() const;
+    /** Perform the nbShortRun_ initialization steps, run in parallel the short
+     *  algorithms and select the best model.
+     *  @param p_bestShortModel a pointer on the best model found
+     *  @return @c false if an initialization step failed, @c true otherwise
+     **/
+    bool parallelShortRuns(IMixtureComposer*& p_bestShortModel);
 };
 
 }  // namespace STK
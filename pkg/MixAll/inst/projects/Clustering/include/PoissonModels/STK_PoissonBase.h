@@ -34,9 +34,13 @@
 #ifndef STK_POISSONBASE_H
 #define STK_POISSONBASE_H
 
+#include <vector>
+#include <utility>
+
 #include "../STK_IMixtureDensity.h"
 
 #include <STatistiK/include/STK_Law_Poisson.h>
+#include <Analysis/include/STK_Funct_gamma.h>
 #include "../PoissonModels/STK_PoissonParameters.h"
 
 namespace STK
@@ -57,23 +61,44 @@ class PoissonBase: public IMixtureDensity<Derived >
     /** default constructor
      *  @param nbCluster number of cluster in the model
      **/
-    PoissonBase( int nbCluster): Base(nbCluster) {}
+    PoissonBase( int nbCluster)
+               : Base(nbCluster), lnFact_(), lnLambda_(), sumLambda_(), v_nullLambda_()
+    {}
     /** copy constructor
      *  @param model The model to copy
      **/
-    PoissonBase( PoissonBase const& model): Base(model) {}
+    PoissonBase( PoissonBase const& model)
+               : Base(model)
+               , lnFact_(model.lnFact_)
+               , lnLambda_(model.lnLambda_)
+               , sumLambda_(model.sumLambda_)
+               , v_nullLambda_(model.v_nullLambda_)
+    {}
     /** destructor */
     ~PoissonBase() {}
 
   public:
     /** @return the value of lambda of the kth cluster and jth variable */
     inline Real lambda(int k, int j) const { return param_.lambda(k,j);}
-    /** Initialize the parameters of the model. */
-    void initializeModelImpl() { param_.resize(p_data()->cols());}
+    /** Initialize the parameters of the model and the cached values. */
+    void initializeModelImpl();
+    /** Update the cached logarithms and sums of the lambdas */
+    void parametersChangedImpl();
+    /** Update the cached sums of the ln(x_ij!) of the samples with missing
+     *  values.
+     *  @param v_missing indexes (i,j) of the missing values
+     **/
+    template<class MissingIndexes>
+    void missingValuesChangedImpl(MissingIndexes const& v_missing);
     /** @return the value of the probability of the i-th sample in the k-th component.
      *  @param i,k indexes of the sample and of the component
      **/
     Real lnComponentProbability(int i, int k) const;
+    /** Add the log-probabilities of a block of samples to lnComp.
+     *  @param rows range of the samples
+     *  @param lnComp array of size (rows, nbCluster) to update
+     **/
+    void lnComponentProbabilities(Range const& rows, CArrayXX& lnComp) const;
     /** @return an imputation value for the jth variable of the ith sample
      *  @param i,j indexes of the data to impute
      *  @param pk the probabilities of each class for the ith individual
@@ -98,23 +123,126 @@ class PoissonBase: public IMixtureDensity<Derived >
      *  @param os Stream where you want to write the summary of parameters.
      */
     void writeParameters(CArrayXX const* p_tik, ostream& os) const;
+
+  protected:
+    /** sum of the ln(x_ij!) of each sample */
+    CVectorX lnFact_;
+    /** logarithms of the lambdas, stored in an array of size (d, K). A null
+     *  lambda is stored as zero. */
+    CArrayXX lnLambda_;
+    /** sum of the lambdas of each cluster */
+    CPointX sumLambda_;
+    /** (k,j) indexes of the null lambdas. The term of the variable j is
+     *  ignored in the cluster k, thus its ln(x_ij!) have to be added back. */
+    std::vector< std::pair<int,int> > v_nullLambda_;
+    /** @return the sum of the ln(x_ij!) of the ith sample */
+    Real computeLnFact(int i) const
+    {
+      Real sum = 0.;
+      for (int j=p_data()->beginCols(); j<p_data()->endCols(); ++j)
+      { sum += Funct::lgamma(p_data()->elt(i,j) + 1.);}
+      return sum;
+    }
 };
 
+/* Initialize the parameters of the model and the cached values. */
+template<class Derived>
+void PoissonBase<Derived>::initializeModelImpl()
+{
+  param_.resize(p_data()->cols());
+  lnFact_.resize(p_data()->rows());
+  for (int i=p_data()->beginRows(); i<p_data()->endRows(); ++i)
+  { lnFact_[i] = computeLnFact(i);}
+  lnLambda_.resize(p_data()->cols(), nbCluster());
+  sumLambda_.resize(nbCluster());
+  parametersChangedImpl();
+}
+
+/* Update the cached logarithms and sums of the lambdas */
+template<class Derived>
+void PoissonBase<Derived>::parametersChangedImpl()
+{
+  v_nullLambda_.clear();
+  for (int k= lnLambda_.beginCols(); k < lnLambda_.endCols(); ++k)
+  {
+    sumLambda_[k] = 0.;
+    for (int j=lnLambda_.beginRows(); j<lnLambda_.endRows(); ++j)
+    {
+      Real value = lambda(k,j);
+      if (value)
+      {
+        lnLambda_(j,k) = std::log(value);
+        sumLambda_[k] += value;
+      }
+      else
+      {
+        lnLambda_(j,k) = 0.;
+        v_nullLambda_.push_back(std::make_pair(k,j));
+      }
+    }
+  }
+}
+
+/* Update the cached sums of the ln(x_ij!) of the samples with missing values.
+ * Each row is recomputed once, after all the missing values are simulated. */
+template<class Derived>
+template<class MissingIndexes>
+void PoissonBase<Derived>::missingValuesChangedImpl(MissingIndexes const& v_missing)
+{
+  if (v_missing.empty()) return;
+  std::vector<bool> done(lnFact_.size(), false);
+  for (typename MissingIndexes::const_iterator it = v_missing.begin(); it != v_missing.end(); ++it)
+  {
+    const int i = it->first;
+    if (done[i - lnFact_.begin()]) continue;
+    lnFact_[i] = computeLnFact(i);
+    done[i - lnFact_.begin()] = true;
+  }
+}
+
 /* @return the value of the probability of the i-th sample in the k-th component.
  *  @param i,k indexes of the sample and of the component
  **/
 template<class Derived>
 Real PoissonBase<Derived>::lnComponentProbability(int i, int k) const
 {
-  Real sum =0.;
+  Real sum = - sumLambda_[k] - lnFact_[i];
   for (int j=p_data()->beginCols(); j<p_data()->endCols(); ++j)
+  { sum += p_data()->elt(i,j) * lnLambda_(j,k);}
+  for (size_t l = 0; l < v_nullLambda_.size(); ++l)
   {
-    Real value = lambda(k,j);
-    if (value)
-    { sum += Law::Poisson::lpdf(p_data()->elt(i,j), value);}
+    if (v_nullLambda_[l].first == k)
+    { sum += Funct::lgamma(p_data()->elt(i, v_nullLambda_[l].second) + 1.);}
   }
   return sum;
 }
+/* Add the log-probabilities of a block of samples to lnComp. The
+ * log-probabilities are computed as the product of the block of data with
+ * the logarithms of the lambdas, minus the cached constants. */
+template<class Derived>
+void PoissonBase<Derived>::lnComponentProbabilities(Range const& rows, CArrayXX& lnComp) const
+{
+  CArrayXX x(rows, p_data()->cols());
+  for (int j=p_data()->beginCols(); j<p_data()->endCols(); ++j)
+  {
+    for (int i= rows.begin(); i < rows.end(); ++i) { x(i,j) = p_data()->elt(i,j);}
+  }
+  CArrayXX xLnLambda = x * lnLambda_;
+  for (int k= lnComp.beginCols(), kp = xLnLambda.beginCols(); k < lnComp.endCols(); ++k, ++kp)
+  {
+    const Real cst = sumLambda_[kp];
+    for (int i= rows.begin(); i < rows.end(); ++i)
+    { lnComp(i,k) += xLnLambda(i,kp) - cst - lnFact_[i];}
+  }
+  for (size_t l = 0; l < v_nullLambda_.size(); ++l)
+  {
+    const int k = v_nullLambda_[l].first - lnLambda_.beginCols() + lnComp.beginCols();
+    const int j = v_nullLambda_[l].second;
+    for (int i= rows.begin(); i < rows.end(); ++i)
+    { lnComp(i,k) += Funct::lgamma(p_data()->elt(i,j) + 1.);}
+  }
+}
+
 /* Implementation  */
 template<class Derived>
 template<class Weights>
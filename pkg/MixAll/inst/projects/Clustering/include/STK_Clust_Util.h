@@ -289,6 +289,20 @@ enum modelState
   modelFinalized_           ///< the model is finalized
 };
 
+/** @ingroup Clustering
+ *  Number of samples processed at once by the blocked eStep and the blocked
+ *  computation of the log-likelihood.
+ **/
+const int eStepBlockSize_ = 256;
+
+/** @ingroup Clustering
+ *  Maximal number of chunks of samples accumulated in parallel by the
+ *  M-steps. Each chunk is accumulated in its own table and the tables are
+ *  summed in the chunk order, so that the result does not depend on the
+ *  number of threads.
+ **/
+const int mStepMaxChunk_ = 16;
+
 /** @ingroup Clustering
  *  list of the parsimonious covariance models that can be used
  **/
@@ -126,6 +126,14 @@ class IMixture
      * @return the value of component probability in log scale
      */
     virtual Real lnComponentProbability(int sample_num, int Cluster_num) = 0;
+    /** This function can be re-implemented in order to compute efficiently
+     *  the log-component probabilities of a block of samples. The values are
+     *  added to the array lnComp. The default implementation loop over the
+     *  samples and the clusters and call lnComponentProbability(i,k).
+     *  @param rows range of the samples
+     *  @param lnComp array of size (rows, nbCluster) to update
+     */
+    virtual void lnComponentProbabilities(Range const& rows, CArrayXX& lnComp);
     /** This function must return the number of free parameters.
      *  @return Number of free parameters
      */
@@ -39,6 +39,7 @@
 #include "STK_IMixture.h"
 
 #include <DManager/include/STK_DataBridge.h>
+#include <STatistiK/include/STK_Law_Util.h>
 
 namespace STK
 {
@@ -127,7 +128,11 @@ class IMixtureBridge: public IMixture, public IRecursiveTemplate<Derived>
     /** get the parameters of the model */
     inline void getParameters( Parameters& param) const { param = mixture_.param_;}
     /** set the parameters of the model */
-    inline void setParameters( Parameters const& param) { mixture_.param_ = param;}
+    inline void setParameters( Parameters const& param)
+    {
+      mixture_.param_ = param;
+      mixture_.parametersChanged();
+    }
 
     // getter and setter of the parameters using an array
     /** This function is used in order to get the current values of the parameters
@@ -143,7 +148,10 @@ class IMixtureBridge: public IMixture, public IRecursiveTemplate<Derived>
      **/
     template<class Array>
     inline void setParameters(ExprBase<Array> const& param)
-    { mixture_.param_.setParameters(param.asDerived());}
+    {
+      mixture_.param_.setParameters(param.asDerived());
+      mixture_.parametersChanged();
+    }
 
     // start default implementation of virtual method inherited from IMixture
     /** @brief Initialize the mixture model before its use by the composer.
@@ -166,15 +174,29 @@ class IMixtureBridge: public IMixture, public IRecursiveTemplate<Derived>
      **/
     inline virtual Real lnComponentProbability(int i, int k)
     { return mixture_.lnComponentProbability(i, k);}
+    /** @brief Add the log-component probabilities of a block of samples to
+     *  the array lnComp.
+     *  @param rows range of the samples
+     *  @param lnComp array of size (rows, nbCluster) to update
+     **/
+    inline virtual void lnComponentProbabilities(Range const& rows, CArrayXX& lnComp)
+    { mixture_.lnComponentProbabilities(rows, lnComp);}
     /** @brief This function is equivalent to Mstep and must be defined to update
      *  parameters.
      **/
     inline virtual void paramUpdateStep()
-    { if (!mixture_.run( p_tik(), p_tk())) throw Clust::mStepFail_;}
+    {
+      if (!mixture_.run( p_tik(), p_tk())) throw Clust::mStepFail_;
+      mixture_.parametersChanged();
+    }
     /** @brief This function should be used in order to initialize randomly the
      *  parameters of the mixture.
      **/
-    inline virtual void randomInit() { mixture_.randomInit( p_tik(), p_tk());};
+    inline virtual void randomInit()
+    {
+      mixture_.randomInit( p_tik(), p_tk());
+      mixture_.parametersChanged();
+    }
     /** This function must return the number of free parameters.
      *  @return Number of free parameters
      **/
@@ -201,7 +223,10 @@ class IMixtureBridge: public IMixture, public IRecursiveTemplate<Derived>
      *  current value of the parameters.
      **/
     inline virtual void setParametersStep()
-    { mixture_.param_.setStatistics();}
+    {
+      mixture_.param_.setStatistics();
+      mixture_.parametersChanged();
+    }
     /** @brief This step can be used by developer to finalize any thing. It will
      *  be called only once after we finish running the estimation algorithm.
      */
@@ -274,14 +299,40 @@ template< class Derived>
 void IMixtureBridge<Derived>::imputationStep()
 {
   for(ConstIterator it = v_missing().begin(); it!= v_missing().end(); ++it)
-  { p_dataij_->elt(it->first, it->second) = mixture_.impute(it->first, it->second, p_tik()->row(it->first) );}
+  {
+    p_dataij_->elt(it->first, it->second) = mixture_.impute(it->first, it->second, p_tik()->row(it->first) );
+    mixture_.dataChanged(it->first, it->second);
+  }
+  mixture_.missingValuesChanged(v_missing_);
 }
 // implementation
 template< class Derived>
 void IMixtureBridge<Derived>::samplingStep()
 {
-  for(ConstIterator it = v_missing().begin(); it!= v_missing().end(); ++it)
-  { p_dataij_->elt(it->first, it->second) = mixture_.sample(it->first, it->second, p_tik()->row(it->first));}
+  if (v_missing_.empty()) return;
+  // the missing values are simulated by blocks, each block drawing its random
+  // numbers in its own stream, so that the result does not depend on the
+  // number of threads
+  const int nbMiss = v_missing_.size(), size = Clust::eStepBlockSize_;
+  const int nbBlock = (nbMiss + size - 1)/size;
+  const uint64_t seed = Law::randSeed();
+  int b;
+#ifdef _OPENMP
+#pragma omp parallel for if (nbBlock > 1)
+#endif
+  for (b = 0; b < nbBlock; ++b)
+  {
+    RandStream stream(seed, b);
+    Law::StreamScope scope(stream);
+    const int last = std::min((b+1)*size, nbMiss);
+    for (int l = b*size; l < last; ++l)
+    {
+      int i = v_missing_[l].first, j = v_missing_[l].second;
+      p_dataij_->elt(i, j) = mixture_.sample(i, j, p_tik()->row(i));
+      mixture_.dataChanged(i, j);
+    }
+  }
+  mixture_.missingValuesChanged(v_missing_);
 }
 
 // implementation
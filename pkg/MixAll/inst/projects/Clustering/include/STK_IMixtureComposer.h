@@ -38,6 +38,8 @@
 
 #include "STK_IMixtureStatModel.h"
 
+#include <STatistiK/include/STK_RandStream.h>
+
 namespace STK
 {
 
@@ -121,7 +123,9 @@ class IMixtureComposer: public IMixtureStatModel
      *  @return the minimal value of individuals in a class
      **/
     virtual int cStep();
-    /** Simulate zi accordingly to tik and replace tik by zik by calling cStep().
+    /** Simulate zi accordingly to tik and replace tik by zik. The samples are
+     *  simulated by blocks in parallel and the count of the individuals in
+     *  each class is done in the same pass.
      *  @return the minimal value of individuals in a class
      **/
     virtual int sStep();
@@ -169,11 +173,33 @@ class IMixtureComposer: public IMixtureStatModel
      *  @param i index of the the individual
      **/
     void cStep(int i);
+    /** Simulate zi accordingly to tik using a random stream and replace tik
+     *  by zik.
+     *  @param i index of the the individual
+     *  @param stream the random stream to use
+     *  @return the simulated class of the individual
+     **/
+    int sStep(int i, RandStream& stream);
+    /** Simulate the zi of a block of individuals, replace tik by zik and add
+     *  the number of individuals in each class to nk.
+     *  @param rows the range of the individuals
+     *  @param stream the random stream to use
+     *  @param nk array of size nbCluster to update
+     **/
+    void sStep(Range const& rows, RandStream& stream, CPointX& nk);
     /** compute one zi and the next value of the tik for i fixed
      *  @param i the individual
      *  @return the contribution of the individual i to the log-likelihood
      **/
     Real eStep(int i);
+    /** compute the zi and the next values of the tik for a block of
+     *  individuals.
+     *  @param rows the range of the individuals
+     *  @param lnComp auxiliary array of size (rows, nbCluster)
+     *  @return the contribution of the individuals to the log-likelihood or
+     *  -infinity if a log-component probability is not finite
+     **/
+    Real eStep(Range const& rows, CArrayXX& lnComp);
     /** Compute zi using the Map estimate for i fixed */
     void mapStep(int i);
 
@@ -189,10 +215,6 @@ class IMixtureComposer: public IMixtureStatModel
   private:
     /** state of the model*/
     Clust::modelState state_;
-    /** Auxiliary array used in the eStep */
-#ifndef _OPENMP
-    CPointX lnComp_;
-#endif
 };
 
 } // namespace STK
@@ -93,6 +93,13 @@ namespace STK
  *   // default implementation "do nothing" provided to all these methods
  *   bool initializeStepImpl(); // return true by default
  *   void finalizeStepImpl();
+ *   void parametersChangedImpl(); // called when the parameters are modified
+ *   void dataChangedImpl(int i, int j); // called when a missing value is modified
+ *   // called once all the missing values have been imputed or simulated
+ *   template<class MissingIndexes>
+ *   void missingValuesChangedImpl(MissingIndexes const& v_missing);
+ *   // default implementation loop over lnComponentProbability(i,k)
+ *   void lnComponentProbabilities(Range const& rows, CArrayXX& lnComp) const;
  * @endcode
  **/
 template<class Derived>
@@ -163,6 +170,23 @@ class IMixtureDensity: public IRecursiveTemplate<Derived>
     /** @brief This function will be called once the model is estimated.
      *  perform specific model finalization stuff */
     inline void finalizeStep() { this->asDerived().finalizeStepImpl();}
+    /** @brief This function is called each time the parameters of the model
+     *  are modified (estimation, random initialization or setting).
+     *  Derived classes can use it in order to update their cached values. */
+    inline void parametersChanged() { this->asDerived().parametersChangedImpl();}
+    /** @brief This function is called each time the value (i,j) of the data
+     *  set is modified (imputation or simulation of a missing value).
+     *  @param i,j indexes of the modified value
+     **/
+    inline void dataChanged(int i, int j) { this->asDerived().dataChangedImpl(i, j);}
+    /** @brief This function is called once all the missing values of the
+     *  data set have been imputed or simulated. Contrary to dataChanged, it is
+     *  never called concurrently.
+     *  @param v_missing indexes (i,j) of the missing values
+     **/
+    template<class MissingIndexes>
+    inline void missingValuesChanged(MissingIndexes const& v_missing)
+    { this->asDerived().missingValuesChangedImpl(v_missing);}
 
     /** @return a simulated value for the jth variable of the ith sample
      *  @param i,j indexes of the data to impute
@@ -171,6 +195,15 @@ class IMixtureDensity: public IRecursiveTemplate<Derived>
     template<class Weights>
     inline Type sample(int i, int j, Weights const& tk) const
     { return this->asDerived().rand(i, j, Law::Categorical::rand(tk));}
+    /** @brief Add the log-component probabilities of a block of samples to
+     *  the array lnComp.
+     *  This default implementation loop over the samples and the components
+     *  and call @c lnComponentProbability(i,k). Derived classes should
+     *  re-implement it with an efficient (column oriented) computation.
+     *  @param rows range of the samples
+     *  @param lnComp array of size (rows, nbCluster) to update
+     **/
+    void lnComponentProbabilities(Range const& rows, CArrayXX& lnComp) const;
 
   protected:
     /** parameters of the derived mixture model. Should be an instance
@@ -195,6 +228,13 @@ class IMixtureDensity: public IRecursiveTemplate<Derived>
     inline bool initializeStepImpl() { return true;/* do nothing*/}
     /** default implementation of finalizeStepImpl (do nothing) */
     inline void finalizeStepImpl() {/* do nothing*/}
+    /** default implementation of parametersChangedImpl (do nothing) */
+    inline void parametersChangedImpl() {/* do nothing*/}
+    /** default implementation of dataChangedImpl (do nothing) */
+    inline void dataChangedImpl(int, int) {/* do nothing*/}
+    /** default implementation of missingValuesChangedImpl (do nothing) */
+    template<class MissingIndexes>
+    inline void missingValuesChangedImpl(MissingIndexes const&) {/* do nothing*/}
 
     /** Set the number of sample of the model (needed by kernel models)
      *  @param nbSample number of sample of the model
@@ -258,6 +298,17 @@ void IMixtureDensity<Derived>::setData(Array const& data, int nbRow, int nbCol,
 }
 
 
+/* Add the log-component probabilities of a block of samples to lnComp */
+template<class Derived>
+void IMixtureDensity<Derived>::lnComponentProbabilities(Range const& rows, CArrayXX& lnComp) const
+{
+  for (int k= lnComp.beginCols(); k < lnComp.endCols(); ++k)
+  {
+    for (int i= rows.begin(); i < rows.end(); ++i)
+    { lnComp(i,k) += this->asDerived().lnComponentProbability(i,k);}
+  }
+}
+
 /* @brief Initialize the model before its first use.
  * This function is triggered when data set is set.
  * In this interface, the @c initializeModel() method
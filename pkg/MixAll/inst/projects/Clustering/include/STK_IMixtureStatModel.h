@@ -36,7 +36,12 @@
 #ifndef STK_IMIXTURESTATMODEL_H
 #define STK_IMIXTURESTATMODEL_H
 
+#ifdef _OPENMP
+#include <omp.h>
+#endif
+
 #include <StatModels/include/STK_IStatModelBase.h>
+#include <STKernel/include/STK_Profiler.h>
 
 #include "STK_Clust_Util.h"
 #include "STK_IMixtureManager.h"
@@ -151,6 +156,14 @@ class IMixtureStatModel: public IStatModelBase
     inline CVectorXi const& zi() const { return zi_;};
     /** @return a constant reference on the vector of mixture */
     inline std::vector<IMixture*> const& v_mixtures() const { return v_mixtures_;}
+    /** @return the profiler of the model, null if the profiling is disabled */
+    inline Profiler* p_profiler() const { return p_profiler_;}
+    /** set the profiler recording the time spent in each step of the
+     *  estimation. The profiler is shared by the clones of the model and by
+     *  the models created by the model.
+     *  @param p_profiler the profiler, null to disable the profiling
+     **/
+    inline void setProfiler(Profiler* p_profiler) { p_profiler_ = p_profiler;}
 
     /** @return the computed log-likelihood of the i-th sample.
      *  @param i index of the sample
@@ -211,6 +224,13 @@ class IMixtureStatModel: public IStatModelBase
     virtual Real lnComponentProbability(int i, int k) const = 0;
 
     // virtual with default implementation
+    /** Add the log-component probabilities of a block of samples to lnComp.
+     *  The default implementation loop over the samples and the classes
+     *  and call lnComponentProbability(i,k).
+     *  @param rows range of the samples
+     *  @param lnComp array of size (rows, nbCluster) to update
+     **/
+    virtual void lnComponentProbabilities(Range const& rows, CArrayXX& lnComp) const;
     /** @brief Initialize the model before at its first use.
      *  This function can be overloaded in derived class for initialization of
      *  the specific model parameters. It should be called prior to any used of
@@ -320,10 +340,61 @@ class IMixtureStatModel: public IStatModelBase
     void getMissingValues(IMixtureManager<Manager> const& manager, String const& idData, MissingValues& missing) const;
 
   protected:
+    /** @brief Scratch arrays used by the per-sample and per-block hot paths.
+     *  There is one workspace per thread, so that the eStep and the
+     *  log-likelihood computation never allocate memory while running.
+     **/
+    struct Workspace
+    {
+      /** auxiliary array of size nbCluster used by eStep(i) and
+       *  computeLnLikelihood(i) */
+      CPointX lnComp_;
+      /** auxiliary array of size (eStepBlockSize_, nbCluster) used by the
+       *  blocked eStep and log-likelihood computation */
+      CArrayXX lnBlock_;
+      /** CPU time (in seconds) spent by the thread in each mixture during the
+       *  current eStep, merged in the profiler once the eStep is done */
+      std::vector<Real> mixtureTimes_;
+    };
     /** set the number of cluster of the model
      *  @param nbCluster number of cluster of the model
      * */
-    inline void setNbCluster( int nbCluster) { nbCluster_ = nbCluster;}
+    inline void setNbCluster( int nbCluster)
+    { nbCluster_ = nbCluster; initializeWorkspaces();}
+    /** @brief (re)size the workspaces if the number of threads or the number
+     *  of cluster changed. This method has to be called outside of any
+     *  parallel region, before using workspace().
+     **/
+    void initializeWorkspaces() const;
+    /** @return the workspace of the calling thread */
+    inline Workspace& workspace() const
+    {
+#ifdef _OPENMP
+      return v_workspaces_[omp_get_thread_num()];
+#else
+      return v_workspaces_.front();
+#endif
+    }
+    /** @return the workspaces of all the threads. This method has to be called
+     *  outside of any parallel region. */
+    inline std::vector<Workspace>& workspaces() const { return v_workspaces_;}
+    /** @return the range of the b-th block of samples processed by the
+     *  blocked eStep and the blocked log-likelihood computation.
+     *  @param b index of the block (0 based)
+     **/
+    inline Range blockRows(int b) const
+    {
+      int begin = tik_.beginRows() + b * Clust::eStepBlockSize_;
+      return Range(begin, std::min(Clust::eStepBlockSize_, tik_.endRows() - begin));
+    }
+    /** @return the number of blocks of samples */
+    inline int nbBlock() const
+    { return (tik_.sizeRows() + Clust::eStepBlockSize_ - 1)/Clust::eStepBlockSize_;}
+    /** @return the computed log-likelihood of a block of samples.
+     *  @param rows range of the samples
+     *  @param lnComp auxiliary array of size (rows, nbCluster)
+     **/
+    Real computeLnLikelihood(Range const& rows, CArrayXX& lnComp) const;
 
     /** number of cluster. */
     int nbCluster_;
@@ -338,6 +409,12 @@ class IMixtureStatModel: public IStatModelBase
 
     /** vector of pointers to the mixtures components */
     std::vector<IMixture*> v_mixtures_;
+    /** the profiler (not owned), null if the profiling is disabled */
+    Profiler* p_profiler_;
+
+  private:
+    /** per-thread workspaces */
+    mutable std::vector<Workspace> v_workspaces_;
 };
 
 
@@ -90,6 +90,18 @@ class MixtureComposer: public IMixtureComposer
      *  @param i,k indexes of the sample and components
      **/
     virtual Real lnComponentProbability(int i, int k) const;
+    /** Add the log-component probabilities of a block of samples to lnComp.
+     *  @param rows range of the samples
+     *  @param lnComp array of size (rows, nbCluster) to update
+     **/
+    virtual void lnComponentProbabilities(Range const& rows, CArrayXX& lnComp) const;
+    /** compute the zi, the lnLikelihood of the current estimates and the next
+     *  value of the tik. If a profiler is set, the time spent in each mixture
+     *  is accumulated by each thread and added once to the section
+     *  "idData.eStep": this is a CPU time summed over the threads.
+     *  @return the minimal value of tk
+     **/
+    virtual Real eStep();
     /** write the parameters of the model in the stream os. */
     virtual void writeParameters(ostream& os) const;
 
@@ -125,6 +137,7 @@ class MixtureComposer: public IMixtureComposer
     virtual void finalizeStep();
 
   protected:
+    using IMixtureComposer::eStep;
     /** @brief Create the composer using existing data handler and mixtures.
      * This method is essentially used by the create() method and can be
      * reused in derived classes.
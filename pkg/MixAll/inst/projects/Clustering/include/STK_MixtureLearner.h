@@ -91,6 +91,11 @@ class MixtureLearner: public IMixtureLearner
      *  @param i,k indexes of the sample and of the class
      **/
     virtual Real lnComponentProbability(int i, int k) const;
+    /** Add the log-component probabilities of a block of samples to lnComp.
+     *  @param rows range of the samples
+     *  @param lnComp array of size (rows, nbCluster) to update
+     **/
+    virtual void lnComponentProbabilities(Range const& rows, CArrayXX& lnComp) const;
     /** write the parameters of the model in the stream os. */
     virtual void writeParameters(ostream& os) const;
     /** initialize randomly the parameters of the components of the model */
@@ -0,0 +1,490 @@
+/*--------------------------------------------------------------------*/
+/*     Copyright (C) 2004-2016  Serge Iovleff
+
+    This program is free software; you can redistribute it and/or modify
+    it under the terms of the GNU Lesser General Public License as
+    published by the Free Software Foundation; either version 2 of the
+    License, or (at your option) any later version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU Lesser General Public License for more details.
+
+    You should have received a copy of the GNU Lesser General Public
+    License along with this program; if not, write to the
+    Free Software Foundation, Inc.,
+    59 Temple Place,
+    Suite 330,
+    Boston, MA 02111-1307
+    USA
+
+    Contact : S..._Dot_I..._At_stkpp_Dot_org (see copyright for ...)
+*/
+
+/*
+ * Project:  stkpp::Clustering
+ * Purpose:  Score new samples with an estimated mixture model.
+ * Author:   iovleff, S..._Dot_I..._At_stkpp_Dot_org (see copyright for ...)
+ **/
+
+/** @file STK_MixtureScorer.h
+ *  @brief In this file we define the MixtureScorer class and the scorers of
+ *  the diagonal Gaussian, gamma, Poisson and categorical mixtures.
+ **/
+
+#ifndef STK_MIXTURESCORER_H
+#define STK_MIXTURESCORER_H
+
+#include <vector>
+
+#include "STK_Clust_Util.h"
+
+#include <STatistiK/include/STK_Law_Gamma.h>
+#include <Analysis/include/STK_Funct_gamma.h>
+
+namespace STK
+{
+
+/** @ingroup Clustering
+ *  @brief Interface base class of the scorers of a mixture.
+ *
+ *  A scorer is a frozen, read-only version of a mixture: it is build once
+ *  from the estimated parameters of the mixture, precompute all the terms
+ *  which does not depend on the samples and compute the log-probabilities
+ *  of the samples of a data set in each component. The parameters are given
+ *  in the layout used by the mixture managers (see IMixtureManager::getParameters).
+ *  The missing values are ignored, i.e. the density of the observed values
+ *  is computed.
+ **/
+class IMixtureScorer
+{
+  protected:
+    /** constructor.
+     *  @param nbCluster number of cluster of the mixture
+     **/
+    inline IMixtureScorer( int nbCluster): nbCluster_(nbCluster) {}
+
+  public:
+    /** destructor */
+    inline virtual ~IMixtureScorer() {}
+    /** @return the number of cluster */
+    inline int nbCluster() const { return nbCluster_;}
+    /** @return the range of the samples of the current data set */
+    virtual Range rows() const =0;
+    /** Add the log-probabilities of a block of samples to lnComp.
+     *  @param rows range of the samples
+     *  @param lnComp array of size (rows, nbCluster) to update
+     **/
+    virtual void lnComponentProbabilities(Range const& rows, CArrayXX& lnComp) const =0;
+
+  protected:
+    /** number of cluster */
+    int nbCluster_;
+};
+
+/** @ingroup Clustering
+ *  @brief Base class of the scorers of the mixtures using a data set of
+ *  type Data.
+ **/
+template<class Data>
+class IMixtureScorerBase: public IMixtureScorer
+{
+  protected:
+    /** constructor.
+     *  @param nbCluster number of cluster of the mixture
+     **/
+    inline IMixtureScorerBase( int nbCluster): IMixtureScorer(nbCluster), p_data_(0) {}
+
+  public:
+    /** destructor */
+    inline virtual ~IMixtureScorerBase() {}
+    /** @return a pointer on the current data set */
+    inline Data const* p_data() const { return p_data_;}
+    /** set the data set to score. The data set is not copied and have to
+     *  exist while the scorer is used.
+     *  @param data the samples to score
+     **/
+    inline void setData(Data const& data) { p_data_ = &data;}
+    /** @return the range of the samples of the current data set */
+    virtual Range rows() const { return p_data_->rows();}
+
+  protected:
+    /** pointer on the data set */
+    Data const* p_data_;
+};
+
+/** @ingroup Clustering
+ *  @brief Scorer of the diagonal Gaussian mixtures. The rows 2k and 2k+1 of
+ *  the parameters contain the means and the standard deviations of the
+ *  k-th component.
+ **/
+template<class Data>
+class DiagGaussianScorer: public IMixtureScorerBase<Data>
+{
+  public:
+    typedef IMixtureScorerBase<Data> Base;
+    using Base::p_data_;
+    /** constructor.
+     *  @param params the parameters of the mixture
+     *  @param nbCluster number of cluster
+     **/
+    DiagGaussianScorer( ArrayXX const& params, int nbCluster)
+                      : Base(nbCluster)
+                      , mean_(nbCluster, params.sizeCols(), 0.)
+                      , invSigma_(nbCluster, params.sizeCols(), 0.)
+                      , cst_(nbCluster, params.sizeCols(), 0.)
+    {
+      for (int k = 0; k < nbCluster; ++k)
+      {
+        for (int j = 0; j < params.sizeCols(); ++j)
+        {
+          Real s = params(params.beginRows() + 2*k + 1, params.beginCols() + j);
+          // a null standard deviation gives a null contribution
+          if (s)
+          {
+            mean_(baseIdx+k, baseIdx+j)     = params(params.beginRows() + 2*k, params.beginCols() + j);
+            invSigma_(baseIdx+k, baseIdx+j) = 1./s;
+            cst_(baseIdx+k, baseIdx+j)      = -(Const::_LNSQRT2PI_ + std::log(s));
+          }
+        }
+      }
+    }
+    /** destructor */
+    virtual ~DiagGaussianScorer() {}
+    /** Add the log-probabilities of a block of samples to lnComp. */
+    virtual void lnComponentProbabilities(Range const& rows, CArrayXX& lnComp) const
+    {
+      const int shift = baseIdx - p_data_->beginCols();
+      for (int j=p_data_->beginCols(); j<p_data_->endCols(); ++j)
+      {
+        const int jp = j + shift;
+        for (int k= lnComp.beginCols(); k < lnComp.endCols(); ++k)
+        {
+          const int kp = k - lnComp.beginCols() + baseIdx;
+          Real m = mean_(kp, jp), invs = invSigma_(kp, jp), cst = cst_(kp, jp);
+          if (!invs) continue;
+          for (int i= rows.begin(); i < rows.end(); ++i)
+          {
+            Real x = p_data_->elt(i,j);
+            if (Arithmetic<Real>::isNA(x)) continue;
+            Real z = (x - m) * invs;
+            lnComp(i,k) += cst - 0.5 * z * z;
+          }
+        }
+      }
+    }
+
+  private:
+    /** means of the components */
+    CArrayXX mean_;
+    /** inverse of the standard deviations */
+    CArrayXX invSigma_;
+    /** constant terms -ln(sqrt(2 pi) sigma) */
+    CArrayXX cst_;
+};
+
+/** @ingroup Clustering
+ *  @brief Scorer of the gamma mixtures. The rows 2k and 2k+1 of the
+ *  parameters contain the shapes and the scales of the k-th component.
+ **/
+template<class Data>
+class GammaScorer: public IMixtureScorerBase<Data>
+{
+  public:
+    typedef IMixtureScorerBase<Data> Base;
+    using Base::p_data_;
+    /** constructor.
+     *  @param params the parameters of the mixture
+     *  @param nbCluster number of cluster
+     **/
+    GammaScorer( ArrayXX const& params, int nbCluster)
+               : Base(nbCluster)
+               , shape_(nbCluster, params.sizeCols(), 0.)
+               , scale_(nbCluster, params.sizeCols(), 0.)
+               , invScale_(nbCluster, params.sizeCols(), 0.)
+               , lnCst_(nbCluster, params.sizeCols(), 0.)
+    {
+      for (int k = 0; k < nbCluster; ++k)
+      {
+        for (int j = 0; j < params.sizeCols(); ++j)
+        {
+          Real a = params(params.beginRows() + 2*k, params.beginCols() + j);
+          Real b = params(params.beginRows() + 2*k + 1, params.beginCols() + j);
+          // a null shape or scale gives a null contribution
+          if (a && b)
+          {
+            shape_(baseIdx+k, baseIdx+j)    = a;
+            scale_(baseIdx+k, baseIdx+j)    = b;
+            invScale_(baseIdx+k, baseIdx+j) = 1./b;
+            lnCst_(baseIdx+k, baseIdx+j)    = -Funct::lgamma(a) - a * std::log(b);
+          }
+        }
+      }
+    }
+    /** destructor */
+    virtual ~GammaScorer() {}
+    /** Add the log-probabilities of a block of samples to lnComp. The
+     *  logarithm of each value is computed once for all the components. */
+    virtual void lnComponentProbabilities(Range const& rows, CArrayXX& lnComp) const
+    {
+      const int shift = baseIdx - p_data_->beginCols();
+      CVectorX lnx(rows);
+      for (int j=p_data_->beginCols(); j<p_data_->endCols(); ++j)
+      {
+        const int jp = j + shift;
+        for (int i= rows.begin(); i < rows.end(); ++i)
+        {
+          Real x = p_data_->elt(i,j);
+          lnx[i] = (x > 0.) ? std::log(x) : 0.;
+        }
+        for (int k= lnComp.beginCols(); k < lnComp.endCols(); ++k)
+        {
+          const int kp = k - lnComp.beginCols() + baseIdx;
+          Real a = shape_(kp, jp), b = scale_(kp, jp);
+          if (!(a && b)) continue;
+          Real am1 = a - 1., invb = invScale_(kp, jp), cst = lnCst_(kp, jp);
+          for (int i= rows.begin(); i < rows.end(); ++i)
+          {
+            Real x = p_data_->elt(i,j);
+            if (Arithmetic<Real>::isNA(x)) continue;
+            lnComp(i,k) += (x > 0.) ? am1 * lnx[i] - x * invb + cst
+                                    : Law::Gamma::lpdf(x, a, b);
+          }
+        }
+      }
+    }
+
+  private:
+    /** shapes of the components */
+    CArrayXX shape_;
+    /** scales of the components */
+    CArrayXX scale_;
+    /** inverse of the scales */
+    CArrayXX invScale_;
+    /** constant terms -ln(Gamma(a)) - a ln(b) */
+    CArrayXX lnCst_;
+};
+
+/** @ingroup Clustering
+ *  @brief Scorer of the Poisson mixtures. The row k of the parameters
+ *  contains the intensities of the k-th component.
+ **/
+template<class Data>
+class PoissonScorer: public IMixtureScorerBase<Data>
+{
+  public:
+    typedef IMixtureScorerBase<Data> Base;
+    using Base::p_data_;
+    /** constructor.
+     *  @param params the parameters of the mixture
+     *  @param nbCluster number of cluster
+     **/
+    PoissonScorer( ArrayXX const& params, int nbCluster)
+                 : Base(nbCluster)
+                 , lambda_(nbCluster, params.sizeCols(), 0.)
+                 , lnLambda_(nbCluster, params.sizeCols(), 0.)
+    {
+      for (int k = 0; k < nbCluster; ++k)
+      {
+        for (int j = 0; j < params.sizeCols(); ++j)
+        {
+          Real lambda = params(params.beginRows() + k, params.beginCols() + j);
+          // a null intensity gives a null contribution
+          if (lambda)
+          {
+            lambda_(baseIdx+k, baseIdx+j)   = lambda;
+            lnLambda_(baseIdx+k, baseIdx+j) = std::log(lambda);
+          }
+        }
+      }
+    }
+    /** destructor */
+    virtual ~PoissonScorer() {}
+    /** Add the log-probabilities of a block of samples to lnComp. The term
+     *  ln(x!) is computed once for all the components. */
+    virtual void lnComponentProbabilities(Range const& rows, CArrayXX& lnComp) const
+    {
+      const int shift = baseIdx - p_data_->beginCols();
+      CVectorX lnFact(rows);
+      for (int j=p_data_->beginCols(); j<p_data_->endCols(); ++j)
+      {
+        const int jp = j + shift;
+        for (int i= rows.begin(); i < rows.end(); ++i)
+        {
+          int x = p_data_->elt(i,j);
+          lnFact[i] = (x > 0 && !Arithmetic<int>::isNA(x)) ? Funct::lgamma(x + 1.) : 0.;
+        }
+        for (int k= lnComp.beginCols(); k < lnComp.endCols(); ++k)
+        {
+          const int kp = k - lnComp.beginCols() + baseIdx;
+          Real lambda = lambda_(kp, jp), lnLambda = lnLambda_(kp, jp);
+          if (!lambda) continue;
+          for (int i= rows.begin(); i < rows.end(); ++i)
+          {
+            int x = p_data_->elt(i,j);
+            if (Arithmetic<int>::isNA(x)) continue;
+            lnComp(i,k) += (x < 0) ? -Arithmetic<Real>::infinity()
+                                   : x * lnLambda - lambda - lnFact[i];
+          }
+        }
+      }
+    }
+
+  private:
+    /** intensities of the components */
+    CArrayXX lambda_;
+    /** logarithm of the intensities */
+    CArrayXX lnLambda_;
+};
+
+/** @ingroup Clustering
+ *  @brief Scorer of the categorical mixtures. The row k*L+l of the
+ *  parameters contains the probabilities of the modality firstModality+l
+ *  in the k-th component, L being the number of modalities.
+ **/
+template<class Data>
+class CategoricalScorer: public IMixtureScorerBase<Data>
+{
+  public:
+    typedef IMixtureScorerBase<Data> Base;
+    using Base::p_data_;
+    /** constructor.
+     *  @param params the parameters of the mixture
+     *  @param nbCluster number of cluster
+     *  @param firstModality value of the first modality
+     **/
+    CategoricalScorer( ArrayXX const& params, int nbCluster, int firstModality)
+                     : Base(nbCluster)
+                     , nbModalities_(params.sizeRows()/nbCluster)
+                     , firstModality_(firstModality)
+                     , lnProba_(nbCluster*nbModalities_, params.sizeCols(), 0.)
+    {
+      for (int r = 0; r < lnProba_.sizeRows(); ++r)
+      {
+        for (int j = 0; j < params.sizeCols(); ++j)
+        {
+          // a null probability gives a null contribution
+          Real prob = params(params.beginRows() + r, params.beginCols() + j);
+          if (prob) { lnProba_(baseIdx+r, baseIdx+j) = std::log(prob);}
+        }
+      }
+    }
+    /** destructor */
+    virtual ~CategoricalScorer() {}
+    /** Add the log-probabilities of a block of samples to lnComp. */
+    virtual void lnComponentProbabilities(Range const& rows, CArrayXX& lnComp) const
+    {
+      const int shift = baseIdx - p_data_->beginCols();
+      for (int j=p_data_->beginCols(); j<p_data_->endCols(); ++j)
+      {
+        const int jp = j + shift;
+        for (int k= lnComp.beginCols(); k < lnComp.endCols(); ++k)
+        {
+          const int first = baseIdx + (k - lnComp.beginCols()) * nbModalities_;
+          for (int i= rows.begin(); i < rows.end(); ++i)
+          {
+            int l = p_data_->elt(i,j) - firstModality_;
+            // missing values and unknown modalities are ignored
+            if (l >= 0 && l < nbModalities_) { lnComp(i,k) += lnProba_(first + l, jp);}
+          }
+        }
+      }
+    }
+
+  private:
+    /** number of modalities */
+    int nbModalities_;
+    /** value of the first modality */
+    int firstModality_;
+    /** logarithm of the probabilities */
+    CArrayXX lnProba_;
+};
+
+/** @ingroup Clustering
+ *  @brief The MixtureScorer class computes the posterior probabilities, the
+ *  MAP labels and the log-likelihood of new samples using an estimated
+ *  (composed) mixture model.
+ *
+ *  It is the frozen counterpart of a MixtureComposer running the Bayes
+ *  classifier: the logarithms of the proportions and the constant terms of
+ *  each component are computed once at the construction, and the samples
+ *  are scored by blocks of Clust::eStepBlockSize_ rows in parallel. The
+ *  same scorer can be used with successive batches of samples, by setting
+ *  the data sets of its scorers before each call to run().
+ *  @code
+ *    MixtureScorer scorer(pk);
+ *    DiagGaussianScorer<CArrayXX>* p_gauss = new DiagGaussianScorer<CArrayXX>(params, K);
+ *    scorer.registerScorer(p_gauss);
+ *    p_gauss->setData(batch);
+ *    if (!scorer.run()) { ...}
+ *    scorer.tik(); scorer.zi(); scorer.lnFi();
+ *  @endcode
+ **/
+class MixtureScorer: public IRunnerBase
+{
+  public:
+    /** constructor.
+     *  @param pk the proportions of the mixture
+     **/
+    template<class RowVector>
+    MixtureScorer( RowVector const& pk);
+    /** destructor. The registered scorers are deleted. */
+    virtual ~MixtureScorer();
+    /** @return the number of cluster */
+    inline int nbCluster() const { return lnPk_.size();}
+    /** @return the registered scorers */
+    inline std::vector<IMixtureScorer*> const& v_scorers() const { return v_scorers_;}
+    /** @return the posterior probabilities of the last scored samples */
+    inline CArrayXX const& tik() const { return tik_;}
+    /** @return the MAP labels of the last scored samples */
+    inline CVectorXi const& zi() const { return zi_;}
+    /** @return the log-likelihood of each of the last scored samples */
+    inline CVectorX const& lnFi() const { return lnFi_;}
+    /** @return the log-likelihood of the last scored samples */
+    inline Real lnLikelihood() const { return lnFi_.sum();}
+    /** register a scorer. The scorer will be deleted by the MixtureScorer.
+     *  @param p_scorer the scorer to register
+     **/
+    void registerScorer(IMixtureScorer* p_scorer);
+    /** score the samples of the current data sets.
+     *  @return @c false if the log-probability of a sample is infinite
+     **/
+    virtual bool run();
+
+  private:
+    /** logarithm of the proportions */
+    CPointX lnPk_;
+    /** scorers of the mixtures */
+    std::vector<IMixtureScorer*> v_scorers_;
+    /** posterior probabilities */
+    CArrayXX tik_;
+    /** MAP labels */
+    CVectorXi zi_;
+    /** log-likelihood of the samples */
+    CVectorX lnFi_;
+    /** Score a block of samples.
+     *  @param rows range of the samples
+     *  @param lnComp auxiliary array of size (rows, nbCluster)
+     *  @return @c false if the log-probability of a sample is infinite
+     **/
+    bool scoreBlock(Range const& rows, CArrayXX& lnComp);
+    /** copy is forbidden, the scorers are owned */
+    MixtureScorer( MixtureScorer const&);
+    MixtureScorer& operator=( MixtureScorer const&);
+};
+
+template<class RowVector>
+MixtureScorer::MixtureScorer( RowVector const& pk)
+                            : IRunnerBase()
+                            , lnPk_(pk.size())
+                            , v_scorers_()
+                            , tik_(), zi_(), lnFi_()
+{
+  for (int k = pk.begin(), kp = lnPk_.begin(); k < pk.end(); ++k, ++kp)
+  { lnPk_[kp] = std::log(pk[k]);}
+}
+
+} // namespace STK
+
+#endif /* STK_MIXTURESCORER_H */
@@ -74,7 +74,7 @@ class MixtureSemiLearner: public MixtureComposer
      *  @return the minimal value of individuals in a class
      **/
     virtual int cStep();
-    /** Simulate zi accordingly to tik and replace tik by zik by calling cStep().
+    /** Simulate the unknown zi accordingly to tik and replace tik by zik.
      *  @return the minimal value of individuals in a class
      **/
     virtual int sStep();
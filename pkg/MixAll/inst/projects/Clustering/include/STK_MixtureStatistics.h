@@ -0,0 +1,137 @@
+/*--------------------------------------------------------------------*/
+/*     Copyright (C) 2004-2016  Serge Iovleff, Université Lille 1, Inria
+
+    This program is free software; you can redistribute it and/or modify
+    it under the terms of the GNU Lesser General Public License as
+    published by the Free Software Foundation; either version 2 of the
+    License, or (at your option) any later version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU Lesser General Public License for more details.
+
+    You should have received a copy of the GNU Lesser General Public
+    License along with this program; if not, write to the
+    Free Software Foundation, Inc.,
+    59 Temple Place,
+    Suite 330,
+    Boston, MA 02111-1307
+    USA
+
+    Contact : S..._DOT_I..._AT_stkpp.org (see copyright for ...)
+*/
+
+/*
+ * Project:  stkpp::Clustering
+ * Author:   iovleff, serge.iovleff@stkpp.org
+ **/
+
+/** @file STK_MixtureStatistics.h
+ *  @brief In this file we define the functions computing the weighted
+ *  sufficient statistics of a data set for all the components of a mixture.
+ **/
+
+#ifndef STK_MIXTURESTATISTICS_H
+#define STK_MIXTURESTATISTICS_H
+
+#include <vector>
+#include <algorithm>
+
+#include "STK_Clust_Util.h"
+#include <Arrays/include/STK_CArray.h>
+#include <Arrays/include/STK_CArrayPoint.h>
+#include <STatistiK/include/STK_Stat_Functors.h>
+
+namespace STK
+{
+
+namespace Clust
+{
+/** @ingroup Clustering
+ *  Compute the weighted means of the columns of a data set for all the
+ *  components at once. The sums \f$ t_{.k}^T x_{.j} \f$ are computed with a
+ *  single matrix product \f$ T^T X \f$.
+ *  @param data the data set (n x d)
+ *  @param tik the posterior probabilities (n x K)
+ *  @param[out] mean the weighted means (K x d)
+ **/
+template<class Array>
+void weightedMeans( Array const& data, CArrayXX const& tik, CArrayXX& mean)
+{
+  CPointX tk = Stat::sum(tik);
+  mean = tik.transpose() * data;
+  for (int k= mean.beginRows(); k < mean.endRows(); ++k)
+  {
+    if (tk[k] > 0.) { mean.row(k) /= tk[k];}
+    else            { mean.row(k) = 0.;}
+  }
+}
+
+/** @ingroup Clustering
+ *  Compute the weighted means and the weighted (biased) variances of the
+ *  columns of a data set for all the components at once. The means are
+ *  computed with weightedMeans, the variances are then computed in a second
+ *  pass around the mean of each component
+ *  \f$ \sigma^2_{kj} = \frac{1}{t_{.k}} \sum_i t_{ik} (x_{ij} - \mu_{kj})^2 \f$
+ *  (as Stat::varianceWithFixedMean), thus they do not suffer from cancellation.
+ *  The second pass is a single sweep over the blocks of rows: each block of
+ *  the data and of the posterior probabilities is read once for all the
+ *  components. The chunks of rows are accumulated in their own table and the
+ *  tables are summed in the chunk order.
+ *  @param data the data set (n x d)
+ *  @param tik the posterior probabilities (n x K)
+ *  @param[out] mean the weighted means (K x d)
+ *  @param[out] variance the weighted variances (K x d)
+ **/
+template<class Array>
+void weightedMoments( Array const& data, CArrayXX const& tik, CArrayXX& mean, CArrayXX& variance)
+{
+  weightedMeans(data, tik, mean);
+  CPointX tk = Stat::sum(tik);
+  const int nbRow = tik.sizeRows();
+  const int nbChunk = std::max(1, std::min(mStepMaxChunk_, nbRow/eStepBlockSize_));
+  std::vector<CArrayXX> partial(nbChunk);
+  int c;
+#ifdef _OPENMP
+#pragma omp parallel for if (nbChunk > 1)
+#endif
+  for (c = 0; c < nbChunk; ++c)
+  {
+    CArrayXX& sum = partial[c];
+    sum.resize(mean.rows(), mean.cols());
+    sum = 0.;
+    const int begin = tik.beginRows() + (c * nbRow)/nbChunk;
+    const int end   = tik.beginRows() + ((c+1) * nbRow)/nbChunk;
+    for (int first = begin; first < end; first += eStepBlockSize_)
+    {
+      const int last = std::min(first + eStepBlockSize_, end);
+      for (int j= mean.beginCols(); j < mean.endCols(); ++j)
+      {
+        for (int k= mean.beginRows(); k < mean.endRows(); ++k)
+        {
+          Real m = mean(k,j), s = 0.;
+          for (int i = first; i < last; ++i)
+          {
+            Real dev = data.elt(i,j) - m;
+            s += tik(i,k) * dev * dev;
+          }
+          sum(k,j) += s;
+        }
+      }
+    }
+  }
+  variance = partial[0];
+  for (c = 1; c < nbChunk; ++c) { variance += partial[c];}
+  for (int k= variance.beginRows(); k < variance.endRows(); ++k)
+  {
+    if (tk[k] > 0.) { variance.row(k) /= tk[k];}
+    else            { variance.row(k) = 0.;}
+  }
+}
+
+} // namespace Clust
+
+} // namespace STK
+
+#endif /* STK_MIXTURESTATISTICS_H */
@@ -89,6 +89,22 @@ bool FullStrategy::run()
           stk_cout << _T("In FullStrategy::run()") << _T(", iTyry =") << iTry
                    << _T(", init step failed\n");
           stk_cout << msg_error_ << _T("\n");
+#endif
+        }
+      }
+      else if (isParallelShortRun())
+      {
+#ifdef STK_MIXTURE_VERY_VERBOSE
+        stk_cout << _T("In FullStrategy::run(), entering parallel short run steps\n")
+                 << _T("iTyry =") << iTry << _T("\n");
+#endif
+        if (!parallelShortRuns(p_bestShortModel))
+        {
+          msg_error_ += STKERROR_NO_ARG(FullStrategy::run,init step failed\n);
+#ifdef STK_MIXTURE_VERBOSE
+          stk_cout << _T("In FullStrategy::run()") << _T(", iTyry =") << iTry
+                   << _T(", init step failed\n");
+          stk_cout << msg_error_ << _T("\n");
 #endif
         }
       }
@@ -200,6 +216,19 @@ bool FullStrategy::initStep(IMixtureComposer*& p_bestModel)
   stk_cout << _T("Entering FullStrategy::initStep\n");
   stk_cout << _T("nbInitRun = ") <<  p_param_->nbInitRun_ << _T("\n");
 #endif
+  bool flag = initRuns(p_bestModel);
+  if (flag) { flag = shortRun(p_param_->p_shortAlgo_, p_bestModel, msg_error_);}
+#ifdef STK_MIXTURE_VERBOSE
+  stk_cout << _T("FullStrategy::initStep done\n");
+  stk_cout << _T("p_bestModel->lnLikelihood() = ") <<  p_bestModel->lnLikelihood() << _T("\n");
+  stk_cout << _T("+++++>\n");
+#endif
+  return flag;
+}
+
+/* Initialize nbInitRun_ models and select the best model among them */
+bool FullStrategy::initRuns(IMixtureComposer*& p_bestModel)
+{
   bool flag = true;
   IMixtureComposer* p_initModel = 0;
   try
@@ -214,7 +243,7 @@ bool FullStrategy::initStep(IMixtureComposer*& p_bestModel)
       if (!p_init_->run())
       {
 #ifdef STK_MIXTURE_VERBOSE
-        stk_cout << _T("FullStrategy::initStep, iInitRun=") << iInitRun
+        stk_cout << _T("FullStrategy::initRuns, iInitRun=") << iInitRun
                  << _T(", initialization failed:\n");
         stk_cout << p_init_->error() << _T("\n");
 #endif
@@ -229,50 +258,152 @@ bool FullStrategy::initStep(IMixtureComposer*& p_bestModel)
           std::swap(p_initModel, p_bestModel);
           valueBest = value;
 #ifdef STK_MIXTURE_VERY_VERBOSE
-        stk_cout << _T("FullStrategy::initStep, iInitRun =") << iInitRun
+        stk_cout << _T("FullStrategy::initRuns, iInitRun =") << iInitRun
                  << _T(", get a better model with value =") << valueBest << _T("\n");
 #endif
         }
       }
     } // iInitRun
-    // In case we never get a better model, clone current model
-    // and perform short run with the current model
-    if (!p_bestModel) { p_bestModel = p_model_->clone();}
-    p_param_->p_shortAlgo_->setModel(p_bestModel);
-    if (!p_param_->p_shortAlgo_->run())
-    {
-      msg_error_ = STKERROR_NO_ARG(FullStrategy::initStep,short algo failed\n);
-      msg_error_ = p_param_->p_shortAlgo_->error();
-#ifdef STK_MIXTURE_VERBOSE
-      stk_cout << _T("In FullStrategy::initStep() shortAlgo failed:\n");
-      stk_cout << msg_error_ << _T("\n");
-#endif
-    }
   }
   catch (Exception const& e)
   {
     msg_error_ = e.error();
     flag = false;
   }
-  // in case all initialization failed or nbInitRun_ <= 0
+  // In case we never get a better model or nbInitRun_ <= 0, clone current
+  // model and perform short run with the current model
   if (!p_bestModel) { p_bestModel = p_model_->clone();}
   if (p_initModel)
   {
 #ifdef STK_MIXTURE_DEBUG_CREATE
-        stk_cout << _T("FullStrategy::initStep terminated. Deleting p_initModel.\n");
+        stk_cout << _T("FullStrategy::initRuns terminated. Deleting p_initModel.\n");
 #endif
     delete p_initModel; p_initModel = 0;
 #ifdef STK_MIXTURE_DEBUG_CREATE
-        stk_cout << _T("FullStrategy::initStep p_initModel deleted.\n");
+        stk_cout << _T("FullStrategy::initRuns p_initModel deleted.\n");
         stk_cout << _T("p_bestModel->writeParameters\n");
         p_bestModel->writeParameters(stk_cout);
 #endif
   }
+  return flag;
+}
+
+/* Run the short algorithm on a model */
+bool FullStrategy::shortRun(IMixtureAlgo* p_algo, IMixtureComposer* p_model, String& msg) const
+{
+  try
+  {
+    p_algo->setModel(p_model);
+    if (!p_algo->run())
+    {
+      msg = STKERROR_NO_ARG(FullStrategy::shortRun,short algo failed\n);
+      msg += p_algo->error();
 #ifdef STK_MIXTURE_VERBOSE
-  stk_cout << _T("FullStrategy::initStep done\n");
-  stk_cout << _T("p_bestModel->lnLikelihood() = ") <<  p_bestModel->lnLikelihood() << _T("\n");
-  stk_cout << _T("+++++>\n");
+#ifdef _OPENMP
+#pragma omp critical
 #endif
+      { stk_cout << _T("In FullStrategy::shortRun() shortAlgo failed:\n") << msg << _T("\n");}
+#endif
+    }
+  }
+  // no exception can leave the parallel region of parallelShortRuns
+  catch (Exception const& e)
+  {
+    msg = e.error();
+    return false;
+  }
+  catch (std::exception const& e)
+  {
+    msg = e.what();
+    return false;
+  }
+  catch (...)
+  {
+    msg = STKERROR_NO_ARG(FullStrategy::shortRun,unknown error\n);
+    return false;
+  }
+  return true;
+}
+
+/* @return true if the short runs can be performed in parallel. The stochastic
+ * algorithms draw their numbers in a stream owned by each short run. The
+ * missing values are stored in the data sets shared by all the models and
+ * written by each short run, thus these short runs remain sequential.
+ **/
+bool FullStrategy::isParallelShortRun() const
+{
+#ifdef _OPENMP
+  return ( p_param_->parallelShortRun_
+        && p_param_->nbShortRun_ > 1
+        && omp_get_max_threads() > 1
+        && p_model_->computeNbMissingValues() == 0
+         );
+#else
+  return false;
+#endif
+}
+
+/* Perform the initialization steps, run in parallel the short algorithms and
+ * select the best model
+ **/
+bool FullStrategy::parallelShortRuns(IMixtureComposer*& p_bestShortModel)
+{
+  const int nbShortRun = p_param_->nbShortRun_;
+  std::vector<IMixtureComposer*> v_models(nbShortRun, (IMixtureComposer*)0);
+  std::vector<String> v_msg(nbShortRun);
+  std::vector<char> v_initialized(nbShortRun, 1);
+  bool flag = true;
+  // the initializations use the random generator and are thus performed
+  // sequentially: the draws do not depend on the number of threads
+  for (int iShort=0; iShort < nbShortRun; ++iShort)
+  {
+    if (!initRuns(v_models[iShort]))
+    {
+      v_initialized[iShort] = 0;
+      flag = false;
+    }
+  }
+  // run the short algorithms, each thread use its own copy of the algorithm
+  // and each short run draws its random numbers in its own stream, so that
+  // the result does not depend on the number of threads
+  const uint64_t seed = Law::randSeed();
+  int iShort;
+#ifdef _OPENMP
+#pragma omp parallel for schedule(dynamic)
+#endif
+  for (iShort=0; iShort < nbShortRun; ++iShort)
+  {
+    if (v_initialized[iShort])
+    {
+      RandStream stream(seed, iShort);
+      Law::StreamScope scope(stream);
+      IMixtureAlgo* p_algo = p_param_->p_shortAlgo_->clone();
+      if (!shortRun(p_algo, v_models[iShort], v_msg[iShort]))
+      { v_initialized[iShort] = 0;}
+      delete p_algo;
+    }
+  }
+  // select the best model. In case of equality the first one is kept like in
+  // the sequential version
+  Real valueBest = -Arithmetic<Real>::infinity();
+  for (iShort=0; iShort < nbShortRun; ++iShort)
+  {
+    msg_error_ += v_msg[iShort];
+    Real value = v_models[iShort]->lnLikelihood();
+    if( valueBest<value)
+    {
+      std::swap(p_bestShortModel, v_models[iShort]);
+      valueBest  = value;
+#ifdef STK_MIXTURE_VERY_VERBOSE
+      stk_cout << _T("In FullStrategy::parallelShortRuns()")
+               << _T(", iShort =") << iShort
+               << _T(", get better value in short run. valueBest =") << valueBest << _T("\n");
+#endif
+    }
+  }
+  // release memory
+  for (iShort=0; iShort < nbShortRun; ++iShort)
+  { if (v_models[iShort]) delete v_models[iShort];}
   return flag;
 }
 
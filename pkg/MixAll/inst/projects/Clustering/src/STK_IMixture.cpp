@@ -57,6 +57,16 @@ IMixture::~IMixture(){}
 /* set the mixture composer to the mixture */
 void IMixture::setMixtureModel( IMixtureStatModel const* p_composer) { p_composer_ = p_composer;}
 
+/* default implementation of the blocked log-component probabilities */
+void IMixture::lnComponentProbabilities(Range const& rows, CArrayXX& lnComp)
+{
+  for (int k= lnComp.beginCols(); k < lnComp.endCols(); ++k)
+  {
+    for (int i= rows.begin(); i < rows.end(); ++i)
+    { lnComp(i,k) += lnComponentProbability(i,k);}
+  }
+}
+
 /* This function can be used in derived classes to get number of samples.
  *  @return Number of samples.
  *  @note STK_IMixtureStatModel.h is include only here
@@ -59,6 +59,14 @@ IMixtureAlgoPredict::~IMixtureAlgoPredict() {}
 void IMixtureAlgoPredict::setModel(IMixtureComposer* p_model)
 { p_model_ = p_model;}
 
+/* initialize the model and restore its proportions */
+void IMixtureAlgoPredict::initializeModel()
+{
+  CPointX pk(p_model_->pk());
+  p_model_->initializeStep();
+  p_model_->setProportions(pk);
+}
+
 
 /* predict class labels when there is no missing values
  * @return @c true if no error occur, @c false otherwise
@@ -73,7 +81,7 @@ bool IMixtureAlgoPredict::predictBayesClassifier()
 
   try
   {
-    p_model_->initializeStep();
+    initializeModel();
     p_model_->eStep();
     p_model_->mapStep();
     p_model_->finalizeStep();
@@ -106,7 +114,7 @@ bool IMixtureAlgoPredict::burnStep()
 #endif
   try
   {
-    p_model_->initializeStep();
+    initializeModel();
     for (int iter = 0; iter < nbIterLong_; ++iter)
     {
       p_model_->sStep(); // simulate labels
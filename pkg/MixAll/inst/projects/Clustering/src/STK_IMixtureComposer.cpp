@@ -49,18 +49,12 @@ namespace STK
 IMixtureComposer::IMixtureComposer( int nbSample, int nbCluster)
                                   : IMixtureStatModel(nbSample, nbCluster)
                                   , state_(Clust::modelCreated_)
-#ifndef _OPENMP
-                                  , lnComp_(nbCluster)
-#endif
 {}
 
 /* copy constructor */
 IMixtureComposer::IMixtureComposer( IMixtureComposer const& model)
                                   : IMixtureStatModel(model)
                                   , state_(model.state_)
-#ifndef _OPENMP
-                                  , lnComp_(model.lnComp_)
-#endif
 {}
 /* destructor */
 IMixtureComposer::~IMixtureComposer() {}
@@ -169,12 +163,28 @@ int IMixtureComposer::sStep()
 #ifdef STK_MIXTURE_VERY_VERBOSE
   stk_cout << _T("Entering IMixtureComposer::sStep()\n");
 #endif
-  // simulate zi
-  for (int i = zi_.begin(); i< zi_.end(); ++i) { sStep(i);}
+  int b, nb = nbBlock();
+  // each block of samples draws its labels in its own stream, so that the
+  // result does not depend on the number of threads
+  const uint64_t seed = Law::randSeed();
+  // number of individuals in each class for each block
+  CArrayXX nkBlock(Range(0, nb), tik_.cols(), 0.);
+#ifdef _OPENMP
+#pragma omp parallel for if (nb > 1)
+#endif
+  for (b = 0; b < nb; ++b)
+  {
+    RandStream stream(seed, b);
+    CPointX nk(nkBlock.row(b), true);
+    sStep(blockRows(b), stream, nk);
+  }
+  // the counts are exact, the order of the sum does not matter
+  tk_ = Stat::sumByCol(nkBlock);
 #ifdef STK_MIXTURE_VERY_VERBOSE
+  stk_cout << _T("IMixtureComposer::sStep() tk_ = ") << tk_;
   stk_cout << _T("IMixtureComposer::sStep() done\n");
 #endif
-  return cStep();
+  return tk_.minElt();
 }
 
 Real IMixtureComposer::eStep()
@@ -182,12 +192,26 @@ Real IMixtureComposer::eStep()
 #ifdef STK_MIXTURE_VERY_VERBOSE
   stk_cout << _T("Entering IMixtureComposer::eStep()\n");
 #endif
-  Real sum = 0.;
-  int i;
+  ScopedTimer timer(p_profiler_, _T("eStep"));
+  int b, nb = nbBlock(), nbFail = 0;
+  // the contributions of the blocks are summed in a fixed order, so that the
+  // result does not depend on the number of threads
+  std::vector<Real> lnBlock(nb, 0.);
+  initializeWorkspaces();
 #ifdef _OPENMP
-#pragma omp parallel for reduction (+:sum)
+#pragma omp parallel for reduction (+:nbFail)
 #endif
-  for (i = tik_.beginRows(); i < tik_.endRows(); ++i) { sum += eStep(i);}
+  for (b = 0; b < nb; ++b)
+  {
+    Range rows = blockRows(b);
+    CArrayXX& lnComp = workspace().lnBlock_;
+    lnComp.shift(rows.begin(), tik_.beginCols());
+    lnBlock[b] = eStep(rows, lnComp);
+    if (lnBlock[b] == -Arithmetic<Real>::infinity()) { ++nbFail;}
+  }
+  if (nbFail) { throw(Clust::eStepFail_);}
+  Real sum = 0.;
+  for (b = 0; b < nb; ++b) { sum += lnBlock[b];}
   // update ln-likelihood
   setLnLikelihood(sum);
   // compute proportions
@@ -219,12 +243,37 @@ void IMixtureComposer::sStep(int i)
 void IMixtureComposer::cStep(int i)
 { tik_.row(i) = 0.; tik_.elt(i, zi_[i]) = 1.;}
 
+/* Simulate zi accordingly to tik using the stream and replace tik by zik */
+int IMixtureComposer::sStep(int i, RandStream& stream)
+{
+  // inverse of the cdf. u is scaled by the sum of the tik in order to be
+  // robust to rounding errors, and the classes with a null probability are
+  // never selected
+  Real sum = 0.;
+  for (int k=tik_.beginCols(); k< tik_.endCols(); k++) { sum += tik_(i,k);}
+  Real u = stream.randUnif() * sum, cum = 0.;
+  int zi = tik_.beginCols();
+  for (int k=tik_.beginCols(); k< tik_.endCols(); k++)
+  {
+    Real p = tik_(i,k);
+    if (p > 0.) { zi = k; if (u < (cum += p)) break;}
+  }
+  for (int k=tik_.beginCols(); k< tik_.endCols(); k++) { tik_(i,k) = 0.;}
+  tik_(i,zi) = 1.;
+  return (zi_[i] = zi);
+}
+
+/* Simulate the zi of a block of individuals, replace tik by zik and count
+ * the number of individuals in each class */
+void IMixtureComposer::sStep(Range const& rows, RandStream& stream, CPointX& nk)
+{
+  for (int i=rows.begin(); i< rows.end(); ++i) { nk[sStep(i, stream)] += 1.;}
+}
+
 /* compute tik, default implementation. */
 Real IMixtureComposer::eStep(int i)
 {
-#ifdef _OPENMP
-  CPointX lnComp_(tik_.cols());
-#endif
+  CPointX& lnComp_ = workspace().lnComp_;
   // get maximal element of ln(x_i,\theta_k) + ln(p_k)
   for (int k=tik_.beginCols(); k< tik_.endCols(); k++)
   { lnComp_[k] = std::log(pk_[k])+lnComponentProbability(i,k);}
@@ -255,6 +304,49 @@ Real IMixtureComposer::eStep(int i)
   return max + std::log( sum );
 }
 
+/* compute tik for a block of individuals. */
+Real IMixtureComposer::eStep(Range const& rows, CArrayXX& lnComp)
+{
+  // compute ln(x_i,\theta_k) + ln(p_k) for all the block
+  lnComp = 0.;
+  lnComponentProbabilities(rows, lnComp);
+  for (int k=tik_.beginCols(); k< tik_.endCols(); k++)
+  {
+    Real lnPk = std::log(pk_[k]);
+    for (int i=rows.begin(); i< rows.end(); ++i) { lnComp(i,k) += lnPk;}
+  }
+  Real sum = 0.;
+  for (int i=rows.begin(); i< rows.end(); ++i)
+  {
+    // get maximal element of ln(x_i,\theta_k) + ln(p_k)
+    int kmax = tik_.beginCols();
+    Real max = -Arithmetic<Real>::max();
+    for (int k=tik_.beginCols(); k< tik_.endCols(); k++)
+    {
+      Real value = lnComp(i,k);
+      if (Arithmetic<Real>::isInfinite(value))
+      {
+#ifdef STK_MIXTURE_VERY_VERBOSE
+        stk_cout << _T("IMixtureComposer::eStep(") << i << _T(")\n");
+        stk_cout << _T("lnComp.row(i) =") << lnComp.row(i);
+#endif
+        return -Arithmetic<Real>::infinity();
+      }
+      if (value > max) { max = value; kmax = k;}
+    }
+    // set zi_
+    zi_[i] = kmax;
+    // max + sum_k p_k exp{lnCom_k - lnComp_kmax}
+    Real sumi = 0.;
+    for (int k=tik_.beginCols(); k< tik_.endCols(); k++)
+    { sumi += (tik_(i,k) = std::exp(lnComp(i,k) - max));}
+    for (int k=tik_.beginCols(); k< tik_.endCols(); k++)
+    { tik_(i,k) /= sumi;}
+    sum += max + std::log(sumi);
+  }
+  return sum;
+}
+
 /* Compute Zi using the Map estimate, default implementation. */
 void IMixtureComposer::mapStep(int i)
 {
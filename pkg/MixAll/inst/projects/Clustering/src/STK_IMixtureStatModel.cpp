@@ -50,7 +50,9 @@ IMixtureStatModel::IMixtureStatModel( int nbSample, int nbCluster)
                                     , tk_(nbCluster, Real(nbSample)/nbCluster)
                                     , zi_(nbSample, baseIdx)
                                     , v_mixtures_()
-{}
+                                    , p_profiler_(0)
+                                    , v_workspaces_()
+{ initializeWorkspaces();}
 
 /* copy constructor */
 IMixtureStatModel::IMixtureStatModel( IMixtureStatModel const& model)
@@ -59,7 +61,10 @@ IMixtureStatModel::IMixtureStatModel( IMixtureStatModel const& model)
                                     , pk_(model.pk_), tik_(model.tik_)
                                     , tk_(model.tk_), zi_(model.zi_)
                                     , v_mixtures_(model.v_mixtures_.size())
+                                    , p_profiler_(model.p_profiler_)
+                                    , v_workspaces_()
 {
+  initializeWorkspaces();
   // clone mixtures
   for (size_t l = 0; l < v_mixtures_.size(); ++l)
   {
@@ -83,7 +88,7 @@ Real IMixtureStatModel::computeLikelihood(int i) const
 Real IMixtureStatModel::computeLnLikelihood(int i) const
 {
   // get maximal value
-  CPointX lnComp(pk_.size());
+  CPointX& lnComp = workspace().lnComp_;
   for (int k = pk_.begin(); k< pk_.end(); ++k)
   { lnComp[k] = std::log(pk_[k]) + lnComponentProbability(i, k);}
   // compute result
@@ -94,12 +99,78 @@ Real IMixtureStatModel::computeLnLikelihood(int i) const
 /* @return the computed log-likelihood. */
 Real IMixtureStatModel::computeLnLikelihood() const
 {
+  int b, nb = nbBlock();
+  // sum the contributions of the blocks in a fixed order
+  std::vector<Real> lnBlock(nb, 0.);
+  initializeWorkspaces();
+#ifdef _OPENMP
+#pragma omp parallel for
+#endif
+  for (b = 0; b < nb; ++b)
+  {
+    Range rows = blockRows(b);
+    CArrayXX& lnComp = workspace().lnBlock_;
+    lnComp.shift(rows.begin(), tik_.beginCols());
+    lnBlock[b] = computeLnLikelihood(rows, lnComp);
+  }
+  Real res = 0.0;
+  for (b = 0; b < nb; ++b) { res += lnBlock[b];}
+  return res;
+}
+
+/* @return the computed log-likelihood of a block of samples. */
+Real IMixtureStatModel::computeLnLikelihood(Range const& rows, CArrayXX& lnComp) const
+{
+  lnComp = 0.;
+  lnComponentProbabilities(rows, lnComp);
+  for (int k = pk_.begin(); k< pk_.end(); ++k)
+  {
+    Real lnPk = std::log(pk_[k]);
+    for (int i = rows.begin(); i< rows.end(); ++i) { lnComp(i,k) += lnPk;}
+  }
   Real res = 0.0;
-  for (int i = tik().beginRows(); i< tik().endRows(); ++i)
-  { res += computeLnLikelihood(i);}
+  for (int i = rows.begin(); i< rows.end(); ++i)
+  {
+    Real lnCompMax = -Arithmetic<Real>::max();
+    for (int k = pk_.begin(); k< pk_.end(); ++k)
+    { lnCompMax = std::max(lnCompMax, lnComp(i,k));}
+    Real sum = 0.;
+    for (int k = pk_.begin(); k< pk_.end(); ++k)
+    { sum += std::exp(lnComp(i,k) - lnCompMax);}
+    res += std::log(sum)+lnCompMax;
+  }
   return res;
 }
 
+/* default implementation of the blocked log-component probabilities */
+void IMixtureStatModel::lnComponentProbabilities(Range const& rows, CArrayXX& lnComp) const
+{
+  for (int k = lnComp.beginCols(); k< lnComp.endCols(); ++k)
+  {
+    for (int i = rows.begin(); i< rows.end(); ++i)
+    { lnComp(i,k) += lnComponentProbability(i, k);}
+  }
+}
+
+/* (re)size the workspaces if the number of threads or of cluster changed */
+void IMixtureStatModel::initializeWorkspaces() const
+{
+#ifdef _OPENMP
+  size_t nbThread = std::max(omp_get_max_threads(), 1);
+#else
+  size_t nbThread = 1;
+#endif
+  if (v_workspaces_.size() < nbThread) { v_workspaces_.resize(nbThread);}
+  for (size_t t = 0; t < v_workspaces_.size(); ++t)
+  {
+    Workspace& ws = v_workspaces_[t];
+    if (ws.lnComp_.size() != nbCluster_)
+    { ws.lnComp_.resize(nbCluster_);}
+    if (ws.lnBlock_.sizeCols() != nbCluster_ || ws.lnBlock_.sizeRows() != Clust::eStepBlockSize_)
+    { ws.lnBlock_.resize(Clust::eStepBlockSize_, nbCluster_);}
+  }
+}
+
 /* @return the computed ICL criteria. */
 Real IMixtureStatModel::computeICL() const
 {
@@ -193,6 +264,8 @@ void IMixtureStatModel::initializeStep()
   if (v_mixtures_.size() == 0)
     STKRUNTIME_ERROR_NO_ARG(IMixtureStatModel::initializeStep,no mixture registered);
   setLnLikelihood(-Arithmetic<Real>::infinity());
+  // (re)size the thread workspaces
+  initializeWorkspaces();
   // initialize registered mixtures
   for (MixtIterator it = v_mixtures_.begin(); it != v_mixtures_.end(); ++it)
   { (*it)->initializeStep();}
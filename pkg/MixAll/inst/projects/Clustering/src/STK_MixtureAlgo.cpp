@@ -40,6 +40,47 @@
 
 namespace STK
 {
+
+namespace hidden
+{
+/** @ingroup hidden
+ *  Record in the profiler of a model the time of a run of an algorithm, its
+ *  number of iterations and the trace of the ln-likelihood. Nothing is done if
+ *  the profiling is disabled.
+ **/
+class AlgoProfile
+{
+  public:
+    /** constructor
+     *  @param p_model the model estimated by the algorithm
+     *  @param name name of the algorithm
+     **/
+    AlgoProfile( IMixtureComposer const* p_model, String const& name)
+               : p_profiler_(p_model->p_profiler()), name_(name)
+               , timer_(p_profiler_, name), trace_()
+    {}
+    /** destructor. Store the number of iterations and the trace. */
+    ~AlgoProfile()
+    {
+      if (!p_profiler_) return;
+      p_profiler_->count(name_ + _T(".iterations"), int(trace_.size()));
+      p_profiler_->addSeries(name_ + _T(".lnLikelihood"), trace_);
+    }
+    /** record an iteration
+     *  @param lnLikelihood the current value of the ln-likelihood
+     **/
+    inline void iteration(Real lnLikelihood)
+    { if (p_profiler_) { trace_.push_back(lnLikelihood);}}
+
+  private:
+    Profiler* p_profiler_;
+    String name_;
+    ScopedTimer timer_;
+    std::vector<Real> trace_;
+};
+
+} // namespace hidden
+
 /* run the CEM algorithm */
 bool CEMAlgo::run()
 {
@@ -48,6 +89,7 @@ bool CEMAlgo::run()
            << _T("nbIterMax_ = ") << nbIterMax_
            << _T(", epsilon_ = ") << epsilon_ << _T("\n");
 #endif
+  hidden::AlgoProfile profile(p_model_, _T("CEMAlgo"));
   try
   {
     Real currentLnLikelihood =  p_model_->lnLikelihood();
@@ -66,6 +108,7 @@ bool CEMAlgo::run()
       p_model_->pStep();
       p_model_->paramUpdateStep();
       Real nb = p_model_->eStep();
+      profile.iteration(p_model_->lnLikelihood());
       if (nb<threshold_)
       {
         msg_error_ = STKERROR_1ARG(CEMAlgo::run,nb,Not enough individuals after eStep\n);
@@ -110,6 +153,7 @@ bool EMAlgo::run()
            << _T("nbIterMax_ = ") << nbIterMax_ << _T("\n")
            << _T("epsilon_ = ") << epsilon_ << _T("\n");
 #endif
+  hidden::AlgoProfile profile(p_model_, _T("EMAlgo"));
 
   try
   {
@@ -121,6 +165,7 @@ bool EMAlgo::run()
       p_model_->pStep();
       p_model_->paramUpdateStep();
       Real nb = p_model_->eStep();
+      profile.iteration(p_model_->lnLikelihood());
       if (nb<threshold_)
       {
         msg_error_ = STKERROR_1ARG(EMAlgo::run,nb,Not enough individuals after eStep\n);
@@ -166,6 +211,7 @@ bool SEMAlgo::run()
            << _T("nbIterMax_ = ") << nbIterMax_ << _T("\n")
            << _T("p_model_->lnLikelihood = ") << p_model_->lnLikelihood() << _T("\n");
 #endif
+  hidden::AlgoProfile profile(p_model_, _T("SEMAlgo"));
   bool result = true;
   try
   {
@@ -186,6 +232,7 @@ bool SEMAlgo::run()
       p_model_->pStep();        // estimate proportions
       p_model_->paramUpdateStep();        // estimate parameters
       nb = p_model_->eStep();   // update tik and lnLikelihood
+      profile.iteration(p_model_->lnLikelihood());
       if (nb<threshold_)
       {
         msg_error_ = STKERROR_1ARG(SEMAlgo::run,nb,Not enough individuals after eStep\n);
@@ -236,6 +283,7 @@ bool SemiSEMAlgo::run()
            << _T("nbIterMax_ = ") << nbIterMax_ << _T("\n")
            << _T("p_model_->lnLikelihood = ") << p_model_->lnLikelihood() << _T("\n");
 #endif
+  hidden::AlgoProfile profile(p_model_, _T("SemiSEMAlgo"));
   bool result = true;
   try
   {
@@ -246,6 +294,7 @@ bool SemiSEMAlgo::run()
       p_model_->pStep();
       p_model_->paramUpdateStep();
       Real nb = p_model_->eStep();
+      profile.iteration(p_model_->lnLikelihood());
       if (nb<threshold_)
       {
         msg_error_ = STKERROR_1ARG(SemiSEMAlgo::run,nb,Not enough individuals after eStep\n);
@@ -52,7 +52,7 @@ bool EMPredict::run()
 #endif
   try
   {
-    p_model_->initializeStep();
+    initializeModel();
     if (!burnStep())
     {
       p_model_->mapStep();
@@ -125,7 +125,7 @@ bool SemiSEMPredict::run()
 #endif
   try
   {
-    p_model_->initializeStep();
+    initializeModel();
     if (!burnStep())
     {
       p_model_->mapStep();
@@ -66,6 +66,7 @@ MixtureComposer* MixtureComposer::create() const
 {
   // set dimensions
   MixtureComposer* p_composer = new MixtureComposer(nbSample(), nbCluster());
+  p_composer->setProfiler(p_profiler_);
   p_composer->createComposer( v_mixtures_);
   return p_composer;
 }
@@ -78,13 +79,55 @@ Real MixtureComposer::lnComponentProbability(int i, int k) const
   return sum;
 }
 
+void MixtureComposer::lnComponentProbabilities(Range const& rows, CArrayXX& lnComp) const
+{
+  if (!p_profiler_)
+  {
+    for (ConstMixtIterator it = v_mixtures_.begin() ; it != v_mixtures_.end(); ++it)
+    { (*it)->lnComponentProbabilities(rows, lnComp);}
+    return;
+  }
+  // time each mixture in the workspace of the thread, merged by eStep()
+  std::vector<Real>& times = workspace().mixtureTimes_;
+  if (times.size() < v_mixtures_.size()) { times.resize(v_mixtures_.size(), 0.);}
+  size_t l = 0;
+  for (ConstMixtIterator it = v_mixtures_.begin() ; it != v_mixtures_.end(); ++it, ++l)
+  {
+    ScopedTimer::Clock::time_point start = ScopedTimer::Clock::now();
+    (*it)->lnComponentProbabilities(rows, lnComp);
+    times[l] += std::chrono::duration<Real>(ScopedTimer::Clock::now() - start).count();
+  }
+}
+
+Real MixtureComposer::eStep()
+{
+  if (!p_profiler_) { return IMixtureComposer::eStep();}
+  initializeWorkspaces();
+  std::vector<Workspace>& ws = workspaces();
+  for (size_t t = 0; t < ws.size(); ++t)
+  { ws[t].mixtureTimes_.assign(v_mixtures_.size(), 0.);}
+  Real res = IMixtureComposer::eStep();
+  // merge the times of the threads: one call per mixture and per eStep
+  for (size_t l = 0; l < v_mixtures_.size(); ++l)
+  {
+    Real time = 0.;
+    for (size_t t = 0; t < ws.size(); ++t) { time += ws[t].mixtureTimes_[l];}
+    p_profiler_->add(v_mixtures_[l]->idData() + _T(".eStep"), time);
+  }
+  return res;
+}
+
 void MixtureComposer::paramUpdateStep()
 {
 #ifdef STK_MIXTURE_VERY_VERBOSE
   stk_cout << _T("Entering MixtureComposer::paramUpdateStep()\n");
 #endif
+  ScopedTimer timer(p_profiler_, _T("paramUpdateStep"));
   for (MixtIterator it = v_mixtures_.begin() ; it != v_mixtures_.end(); ++it)
-  { (*it)->paramUpdateStep();}
+  {
+    ScopedTimer mixtureTimer(p_profiler_, (*it)->idData(), _T("paramUpdateStep"));
+    (*it)->paramUpdateStep();
+  }
 #ifdef STK_MIXTURE_VERY_VERBOSE
   stk_cout << _T("MixtureComposer::paramUpdateStep() done\n");
 #endif
@@ -133,8 +176,12 @@ void MixtureComposer::randomInit()
 
 void MixtureComposer::imputationStep()
 {
+  ScopedTimer timer(p_profiler_, _T("imputationStep"));
   for (MixtIterator it = v_mixtures_.begin(); it != v_mixtures_.end(); ++it)
-  { (*it)->imputationStep();}
+  {
+    ScopedTimer mixtureTimer(p_profiler_, (*it)->idData(), _T("imputationStep"));
+    (*it)->imputationStep();
+  }
 }
 
 /* @brief Simulation of all the latent variables and/or missing data
@@ -145,9 +192,12 @@ void MixtureComposer::samplingStep()
 #ifdef STK_MIXTURE_VERY_VERBOSE
   stk_cout << _T("Entering MixtureComposer::samplingStep()\n");
 #endif
-
+  ScopedTimer timer(p_profiler_, _T("samplingStep"));
   for (MixtIterator it = v_mixtures_.begin(); it != v_mixtures_.end(); ++it)
-  { (*it)->samplingStep();}
+  {
+    ScopedTimer mixtureTimer(p_profiler_, (*it)->idData(), _T("samplingStep"));
+    (*it)->samplingStep();
+  }
 #ifdef STK_MIXTURE_VERY_VERBOSE
   stk_cout << _T("MixtureComposer::samplingStep() done\n");
 #endif
@@ -215,6 +265,7 @@ MixtureComposerFixedProp::MixtureComposerFixedProp( MixtureComposer const& model
 MixtureComposerFixedProp* MixtureComposerFixedProp::create() const
 {
   MixtureComposerFixedProp* p_composer = new MixtureComposerFixedProp(nbSample(), nbCluster());
+  p_composer->setProfiler(p_profiler_);
   p_composer->createComposer(v_mixtures_);
   p_composer->setNbFreeParameter(p_composer->nbFreeParameter()-(nbCluster()-1));
   return p_composer;
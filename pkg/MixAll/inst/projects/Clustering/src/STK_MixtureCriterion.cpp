@@ -44,6 +44,7 @@ bool AICMixtureCriterion::run()
   { msg_error_ = STKERROR_NO_ARG(AICMixtureCriterion::run,p_composer_ is not set);
     return false;
   }
+  ScopedTimer timer(p_composer_->p_profiler(), _T("criterion"));
   value_  = p_composer_->computeAIC();
   return true;
 }
@@ -55,6 +56,7 @@ bool BICMixtureCriterion::run()
   { msg_error_ = STKERROR_NO_ARG(BICMixtureCriterion::run,p_composer_ is not set);
     return false;
   }
+  ScopedTimer timer(p_composer_->p_profiler(), _T("criterion"));
   value_  = p_composer_->computeBIC();
   return true;
 }
@@ -66,6 +68,7 @@ bool ICLMixtureCriterion::run()
   { msg_error_ = STKERROR_NO_ARG(ICLMixtureCriterion::run,p_composer_ is not set);
     return false;
   }
+  ScopedTimer timer(p_composer_->p_profiler(), _T("criterion"));
   value_  = p_composer_->computeICL();
   return true;
 }
@@ -77,6 +80,7 @@ bool MLMixtureCriterion::run()
   { msg_error_ = STKERROR_NO_ARG(MLMixtureCriterion::run,p_composer_ is not set);
     return false;
   }
+  ScopedTimer timer(p_composer_->p_profiler(), _T("criterion"));
   value_  = -2 * p_composer_->lnLikelihood();
   return true;
 }
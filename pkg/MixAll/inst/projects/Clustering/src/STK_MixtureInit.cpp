@@ -68,6 +68,7 @@ bool RandomInit::run()
            << _T("Entering RandomInit::run()\n")
            << _T("nbTry = ") << nbTry_ << _T("\n");
 #endif
+  ScopedTimer timer(p_model_->p_profiler(), _T("initialization"));
   bool result = false;
   int iTry;
   for (iTry= 0; iTry < nbTry_; ++iTry)
@@ -118,6 +119,7 @@ bool ClassInit::run()
            << _T("Entering ClassInit::run()\n")
            << _T("nbTry = ") << nbTry_ << _T("\n");
 #endif
+  ScopedTimer timer(p_model_->p_profiler(), _T("initialization"));
   bool result = false;
   int iTry;
   for (iTry= 0; iTry < nbTry_; ++iTry)
@@ -169,6 +171,7 @@ bool FuzzyInit::run()
            << _T("Entering FuzzyInit::run()\n")
            << _T("nbTry = ") << nbTry_ << _T("\n");
 #endif
+  ScopedTimer timer(p_model_->p_profiler(), _T("initialization"));
   bool result = false;
   int iTry;
   for (iTry= 0; iTry < nbTry_; ++iTry)
@@ -65,6 +65,7 @@ MixtureLearner* MixtureLearner::create() const
 {
   // set dimensions
   MixtureLearner* p_composer = new MixtureLearner(nbSample(), nbCluster());
+  p_composer->setProfiler(p_profiler_);
   p_composer->createLearner( v_mixtures_);
   return p_composer;
 }
@@ -77,6 +78,12 @@ Real MixtureLearner::lnComponentProbability(int i, int k) const
   return sum;
 }
 
+void MixtureLearner::lnComponentProbabilities(Range const& rows, CArrayXX& lnComp) const
+{
+  for (ConstMixtIterator it = v_mixtures_.begin() ; it != v_mixtures_.end(); ++it)
+  { (*it)->lnComponentProbabilities(rows, lnComp);}
+}
+
 void MixtureLearner::paramUpdateStep()
 {
   for (MixtIterator it = v_mixtures_.begin() ; it != v_mixtures_.end(); ++it)
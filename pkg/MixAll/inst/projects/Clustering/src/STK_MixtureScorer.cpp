@@ -0,0 +1,138 @@
+/*--------------------------------------------------------------------*/
+/*     Copyright (C) 2004-2016  Serge Iovleff
+
+    This program is free software; you can redistribute it and/or modify
+    it under the terms of the GNU Lesser General Public License as
+    published by the Free Software Foundation; either version 2 of the
+    License, or (at your option) any later version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU Lesser General Public License for more details.
+
+    You should have received a copy of the GNU Lesser General Public
+    License along with this program; if not, write to the
+    Free Software Foundation, Inc.,
+    59 Temple Place,
+    Suite 330,
+    Boston, MA 02111-1307
+    USA
+
+    Contact : S..._Dot_I..._At_stkpp_Dot_org (see copyright for ...)
+*/
+
+/*
+ * Project:  stkpp::Clustering
+ * Purpose:  Score new samples with an estimated mixture model.
+ * Author:   iovleff, S..._Dot_I..._At_stkpp_Dot_org (see copyright for ...)
+ **/
+
+/** @file STK_MixtureScorer.cpp
+ *  @brief In this file we implement the MixtureScorer class.
+ **/
+
+#include <cmath>
+
+#include "../include/STK_MixtureScorer.h"
+
+namespace STK
+{
+MixtureScorer::~MixtureScorer()
+{
+  for (size_t l = 0; l < v_scorers_.size(); ++l) { delete v_scorers_[l];}
+}
+
+/* register a scorer */
+void MixtureScorer::registerScorer(IMixtureScorer* p_scorer)
+{
+  if (p_scorer->nbCluster() != nbCluster())
+  { STKRUNTIME_ERROR_NO_ARG(MixtureScorer::registerScorer,wrong number of cluster);}
+  v_scorers_.push_back(p_scorer);
+}
+
+/* score the samples of the current data sets */
+bool MixtureScorer::run()
+{
+  if (v_scorers_.empty())
+  {
+    msg_error_ = STKERROR_NO_ARG(MixtureScorer::run,no scorer registered);
+    return false;
+  }
+  Range rows = v_scorers_.front()->rows();
+  for (size_t l = 1; l < v_scorers_.size(); ++l)
+  {
+    if (v_scorers_[l]->rows() != rows)
+    {
+      msg_error_ = STKERROR_NO_ARG(MixtureScorer::run,data sets have different rows);
+      return false;
+    }
+  }
+  tik_.resize(rows, lnPk_.range());
+  zi_.resize(rows);
+  lnFi_.resize(rows);
+  const int size = Clust::eStepBlockSize_;
+  const int nb = (rows.size() + size - 1)/size;
+  int nbFail = 0;
+#ifdef _OPENMP
+#pragma omp parallel reduction (+:nbFail)
+#endif
+  {
+    // one auxiliary array by thread
+    CArrayXX lnComp(size, lnPk_.range());
+#ifdef _OPENMP
+#pragma omp for schedule(static)
+#endif
+    for (int b = 0; b < nb; ++b)
+    {
+      int begin = rows.begin() + b * size;
+      Range block(begin, std::min(size, rows.end() - begin));
+      lnComp.shift(begin, lnPk_.begin());
+      if (!scoreBlock(block, lnComp)) { ++nbFail;}
+    }
+  }
+  if (nbFail)
+  {
+    msg_error_ = Clust::exceptionToString(Clust::eStepFail_);
+    return false;
+  }
+  hasRun_ = true;
+  return true;
+}
+
+/* Score a block of samples */
+bool MixtureScorer::scoreBlock(Range const& rows, CArrayXX& lnComp)
+{
+  // compute ln(x_i,\theta_k) + ln(p_k) for all the block
+  lnComp = 0.;
+  for (size_t l = 0; l < v_scorers_.size(); ++l)
+  { v_scorers_[l]->lnComponentProbabilities(rows, lnComp);}
+  for (int k=lnPk_.begin(); k< lnPk_.end(); k++)
+  {
+    Real lnPk = lnPk_[k];
+    for (int i=rows.begin(); i< rows.end(); ++i) { lnComp(i,k) += lnPk;}
+  }
+  for (int i=rows.begin(); i< rows.end(); ++i)
+  {
+    // get maximal element of ln(x_i,\theta_k) + ln(p_k)
+    int kmax = lnPk_.begin();
+    Real max = -Arithmetic<Real>::max();
+    for (int k=lnPk_.begin(); k< lnPk_.end(); k++)
+    {
+      Real value = lnComp(i,k);
+      if (Arithmetic<Real>::isInfinite(value)) { return false;}
+      if (value > max) { max = value; kmax = k;}
+    }
+    zi_[i] = kmax;
+    // max + sum_k p_k exp{lnCom_k - lnComp_kmax}
+    Real sumi = 0.;
+    for (int k=lnPk_.begin(); k< lnPk_.end(); k++)
+    { sumi += (tik_(i,k) = std::exp(lnComp(i,k) - max));}
+    for (int k=lnPk_.begin(); k< lnPk_.end(); k++)
+    { tik_(i,k) /= sumi;}
+    lnFi_[i] = max + std::log(sumi);
+  }
+  return true;
+}
+
+} // namespace STK
@@ -74,6 +74,7 @@ MixtureSemiLearner* MixtureSemiLearner::create() const
 {
   // set dimensions
   MixtureSemiLearner* p_composer = new MixtureSemiLearner(nbSample(), nbCluster());
+  p_composer->setProfiler(p_profiler_);
   p_composer->createSemiLearner(this);
   p_composer->createComposer(v_mixtures());
   return p_composer;
@@ -94,11 +95,25 @@ int MixtureSemiLearner::cStep()
 /* simulate zi  */
 int MixtureSemiLearner::sStep()
 {
-  // simulate zi
-  std::vector<int>::const_iterator it;
-  for (it=unknownLabels_.begin(); it != unknownLabels_.end(); it++)
-  { MixtureComposer::sStep(*it);}
-  return cStep();
+  // simulate the unknown zi by blocks, each block drawing its labels in its
+  // own stream
+  const int nbUnknown = unknownLabels_.size(), size = Clust::eStepBlockSize_;
+  const int nbBlock = (nbUnknown + size - 1)/size;
+  const uint64_t seed = Law::randSeed();
+  int b;
+#ifdef _OPENMP
+#pragma omp parallel for if (nbBlock > 1)
+#endif
+  for (b = 0; b < nbBlock; ++b)
+  {
+    RandStream stream(seed, b);
+    const int last = std::min((b+1)*size, nbUnknown);
+    for (int l = b*size; l < last; ++l)
+    { MixtureComposer::sStep(unknownLabels_[l], stream);}
+  }
+  // count the number of individuals in each class
+  tk_= Stat::sum(tik_);
+  return tk_.minElt();
 }
 
 /* compute tik, default implementation. */
@@ -198,6 +213,7 @@ MixtureSemiLearnerFixedProp::MixtureSemiLearnerFixedProp( MixtureSemiLearnerFixe
 MixtureSemiLearnerFixedProp* MixtureSemiLearnerFixedProp::create() const
 {
   MixtureSemiLearnerFixedProp* p_composer = new MixtureSemiLearnerFixedProp(nbSample(), nbCluster());
+  p_composer->setProfiler(p_profiler_);
   p_composer->createSemiLearner(this);
   p_composer->createComposer(v_mixtures());
   /* remove the count of the pk parameters */
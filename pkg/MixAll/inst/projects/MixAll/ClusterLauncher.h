@@ -43,7 +43,11 @@ namespace STK
 {
 
 /**The ClusterLauncher allow to create the strategy for estimating a mixture model
- * with less effort
+ * with less effort.
+ *
+ * If the R option @c MixAll.profile is @c TRUE, the time spent in each step
+ * of the estimation of the best model, its number of iterations and the trace
+ * of its ln-likelihood are stored in the slot @c profile of the model.
  **/
 class ClusterLauncher: public ILauncher
 {
@@ -75,6 +79,29 @@ class ClusterLauncher: public ILauncher
     String           criterion_;
 
   private:
+    /** @brief A task of the model selection grid.
+     *  A task estimates a composer for a given model and number of cluster
+     *  and computes its criterion value.
+     **/
+    struct GridTask
+    {
+      /** id of the data set to model, empty if all the data sets are used */
+      String idData_;
+      /** name of the model */
+      String idModel_;
+      /** number of cluster */
+      int nbCluster_;
+      /** @c true if the proportions are free */
+      bool freeProp_;
+      /** the composer estimated by the task */
+      IMixtureComposer* p_composer_;
+      /** value of the criterion */
+      Real criterion_;
+      /** error message of the task */
+      String msg_error_;
+      /** @c true if an exception occurred during the estimation */
+      bool failed_;
+    };
     /** Select the best model among the models and nbCluster given.
      *  @return the value of the best criteria.
      **/
@@ -83,10 +110,35 @@ class ClusterLauncher: public ILauncher
      *  @return the value of the best criteria.
      **/
     Real selectBestMixedModel();
+    /** Estimate all the tasks of the grid and store the best composer in
+     *  p_composer_. The tasks are created by batches of nbGridThread() tasks
+     *  which are then estimated concurrently. The best model is selected in
+     *  the order of the grid, so that the result does not depend on the
+     *  number of threads.
+     *  @param v_tasks the tasks of the grid
+     *  @param nbSample number of samples
+     *  @param critValue the criterion value to improve, updated with the
+     *  criterion value of the best task
+     *  @return the index of the best task, -1 if no task improved critValue
+     **/
+    int runGrid( std::vector<GridTask>& v_tasks, int nbSample, Real& critValue);
+    /** @return the number of tasks of the grid estimated concurrently */
+    int nbGridThread() const;
+    /** @return @c true if the R option MixAll.profile is set to @c TRUE */
+    static bool isProfilingEnabled();
+    /** @return the report of profiler_ as a R list with the elements
+     *  @c sections (data.frame with the time and the number of calls of each
+     *  section) and @c series (list of the traces).
+     **/
+    Rcpp::List profileToList() const;
     /** pointer on the main composer */
     IMixtureComposer* p_composer_;
     /** Is the model with mixed data ? */
     bool isMixedData_;
+    /** @c true if the estimation is profiled */
+    bool isProfiled_;
+    /** profile of the estimation of the best model */
+    Profiler profiler_;
 };
 
 } // namespace STK
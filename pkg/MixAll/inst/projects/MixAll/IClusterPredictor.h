@@ -36,6 +36,8 @@
 #ifndef STK_ICLUSTERPREDICTOR_H
 #define STK_ICLUSTERPREDICTOR_H
 
+#include <list>
+
 #include "RDataHandler.h"
 #include "ILauncher.h"
 
@@ -63,11 +65,34 @@ class IClusterPredictor: public ILauncher
     IMixtureAlgoPredict* p_algo_;
     /** pointer on the main composer */
     IMixtureComposer* p_composer_;
+    /** numeric data sets used by the scorers */
+    std::list< RMatrix<Real> > lRealData_;
+    /** integer data sets used by the scorers */
+    std::list< RMatrix<Integer> > lIntData_;
 
     /** Get missing values for single component */
     void getMissingValues(Clust::MixtureClass const& classModel, String const& idData);
     /** Get missing values for mixed data */
     void getMissingValues(Clust::MixtureClass const& classModel, String const& idData, int l);
+    /** Add the scorer of a component to a MixtureScorer.
+     *  @param scorer the scorer of the model
+     *  @param s4_component the component with the estimated parameters
+     *  @param r_data the data set of the component
+     *  @return @c false if the component cannot be scored without running the
+     *  prediction algorithm (kernel models and data with missing values)
+     **/
+    bool addScorer( MixtureScorer& scorer, Rcpp::S4 s4_component, SEXP r_data);
+    /** score the data sets and set the results to the R side.
+     *  @param scorer the scorer of the model with all its components added
+     **/
+    bool runScorer( MixtureScorer& scorer);
+    /** check that the values of a categorical data set are modalities of
+     *  the estimated model, i.e. the codes 1..nbModalities of the R factors.
+     *  Throw an exception if a value is out of this range.
+     *  @param s4_component the categorical component of the model
+     *  @param data the categorical data set
+     **/
+    void checkModalities( Rcpp::S4 s4_component, RMatrix<Integer> const& data) const;
 
   private:
     /** utility function creating STK algorithm from R algorithm */
@@ -73,6 +73,12 @@ class ILauncher: public ILauncherBase
     void createDiscreteDataSets(String const& idData, Rcpp::S4 s4_component, Clust::Mixture model);
     /** create the mixtures in the given model */
     void createMixtures(IMixtureStatModel* p_model);
+    /** create the mixture associated to a data set in the given model
+     *  @param p_model the model receiving the mixture
+     *  @param idData the id name of the data set
+     *  @return the mixture created, 0 if no manager can create it
+     **/
+    IMixture* createMixture(IMixtureStatModel* p_model, String const& idData);
 
     /** vector with the model names to try */
     Rcpp::CharacterVector v_models_;
@@ -52,6 +52,8 @@ ClusterLauncher::ClusterLauncher( Rcpp::S4 model, Rcpp::IntegerVector nbCluster,
                                 , criterion_(Rcpp::as<String>(s4_model_.slot("criterionName")))
                                 , p_composer_(0)
                                 , isMixedData_(false)
+                                , isProfiled_(isProfilingEnabled())
+                                , profiler_()
 {}
 /* facade design pattern.
  * The ClusterLauncher allow to create the strategy for estimating a mixture model
@@ -64,7 +66,8 @@ ClusterLauncher::ClusterLauncher( Rcpp::S4 model, Rcpp::IntegerVector nbCluster)
                                 , criterion_(Rcpp::as<String>(s4_model_.slot("criterionName")))
                                 , p_composer_(0)
                                 , isMixedData_(true)
-
+                                , isProfiled_(isProfilingEnabled())
+                                , profiler_()
 {}
 /* destructor. */
 ClusterLauncher::~ClusterLauncher()
@@ -94,6 +97,7 @@ bool ClusterLauncher::run()
     fi[i] = p_composer_->computeLnLikelihood(i);
     zi[i] += (1 - baseIdx);  // set base 1 for the class labels
   }
+  if (isProfiled_) { s4_model_.slot("profile") = profileToList();}
   if (criter == initCriter || !Arithmetic<Real>::isFinite(criter)) return false;
   return true;
 }
@@ -106,9 +110,6 @@ Real ClusterLauncher::selectBestSingleModel()
   double critValue      = s4_model_.slot("criterion");
   int nbSample          = s4_model_.slot("nbSample");
   String idDataBestModel;
-  IMixtureComposer*  p_current   =0;
-  IMixtureCriterion* p_criterion =0;
-
   bool freeProp;
 
   // loop over all the models
@@ -143,50 +144,33 @@ Real ClusterLauncher::selectBestSingleModel()
   // start computation
   try
   {
-    // create criterion
-    p_criterion = Clust::createCriterion(criterion_);
-
-    // start the estimation process, should end with the best model according to
-    // the criteria
-    ClusterFacade facade(p_current);
-    facade.createFullStrategy(s4_strategy_);
-    // loop over all the models
+    // create the grid: a task for each model and each number of cluster
+    std::vector<GridTask> v_tasks;
     for (int l=0; l <v_models_.size(); ++l)
     {
       String idData  = "model" + typeToString<int>(l);
       String idModel = Rcpp::as<String>(v_models_[l]);
-      bool freeProp;
       Clust::stringToMixture(idModel, freeProp);
-      // for the current model,
       for (int k=0; k <v_nbCluster_.length(); ++k)
       {
-        int K = v_nbCluster_[k];
-        // create composer
-        if (freeProp) { p_current = new MixtureComposer(nbSample, K);}
-        else          { p_current = new MixtureComposerFixedProp(nbSample, K);}
-
-        // create current mixture and register it
-        createMixtures(static_cast<MixtureComposer*>(p_current));
-
-        // run estimation and get results if possible
-        if (!facade.run()) { msg_error_ += facade.error();}
-        // compute criterion and update model if necessary
-        p_criterion->setModel(p_current);
-        p_criterion->run();
-        if (critValue > p_criterion->value())
-        {
-          if (p_composer_) { std::swap(p_current, p_composer_);}
-          else             { p_composer_ = p_current; p_current = 0;}
-          s4_component.slot("modelName") = idModel;
-          idDataBestModel                = idData;
-          critValue = p_criterion->value();
-        }
-        // release current composer
-        if (p_current) { delete p_current; p_current = 0;}
+        GridTask task;
+        task.idData_      = idData;
+        task.idModel_     = idModel;
+        task.nbCluster_   = v_nbCluster_[k];
+        task.freeProp_    = freeProp;
+        task.p_composer_  = 0;
+        task.criterion_   = Arithmetic<Real>::max();
+        task.failed_      = false;
+        v_tasks.push_back(task);
       }
     }
-    // release
-    if (p_criterion) { delete p_criterion; p_criterion = 0;}
+    // estimate all the models, p_composer_ is the best model
+    int best = runGrid(v_tasks, nbSample, critValue);
+    if (best >= 0)
+    {
+      s4_component.slot("modelName") = v_tasks[best].idModel_;
+      idDataBestModel                = v_tasks[best].idData_;
+    }
     // get specific parameters
 #ifdef STK_MIXTURE_VERBOSE
   stk_cout << _T("In ClusterLauncher::selectBestSingleModel. Getting Parameters from best model\n");
@@ -196,8 +180,6 @@ Real ClusterLauncher::selectBestSingleModel()
   }
   catch (Exception const& e)
   {
-    if (p_current)   { delete p_current; p_current = 0;}
-    if (p_criterion) { delete p_criterion; p_criterion = 0;}
     ::Rf_error(e.error().c_str()) ;
   }
   // failed
@@ -211,14 +193,8 @@ Real ClusterLauncher::selectBestMixedModel()
   Rcpp::List s4_list =s4_model_.slot("lcomponent");
   Real criter        =s4_model_.slot("criterion");
   int nbSample       =s4_model_.slot("nbSample");
-  // main pointers
-  IMixtureComposer* p_current =0;
-  IMixtureCriterion* p_criterion =0;
   try
   {
-    // create facade and strategy
-    ClusterFacade facade(p_current);
-    facade.createFullStrategy(s4_strategy_);
     bool sameProp = true;
     // loop over the list of component and fill handler_
     for (int l=0; l <s4_list.size(); ++l)
@@ -245,33 +221,20 @@ Real ClusterLauncher::selectBestMixedModel()
         createDataSets(m_data, idData, model);
       }
     }
-    // create criterion
-    p_criterion = Clust::createCriterion(criterion_);
-
+    // create the grid: a task for each number of cluster using all the data sets
+    std::vector<GridTask> v_tasks;
     for (int k=0; k <v_nbCluster_.length(); ++k)
     {
-      int K = v_nbCluster_[k];
-      // create composer
-      if (!sameProp) { p_current = new MixtureComposer(nbSample, K);}
-      else           { p_current = new MixtureComposerFixedProp(nbSample, K);}
-      // create all mixtures
-      createMixtures(static_cast<MixtureComposer*>(p_current));
-      // run estimation and get results if possible
-      if (!facade.run()) { msg_error_ += facade.error();}
-      // compute criterion and update model if necessary
-      p_criterion->setModel(p_current);
-      p_criterion->run();
-      if (criter > p_criterion->value())
-      {
-        criter = p_criterion->value();
-        if (p_composer_) { std::swap(p_current, p_composer_);}
-        else             { p_composer_ = p_current; p_current = 0;}
-      }
-      // release current composer
-      if (p_current) { delete p_current; p_current = 0;}
+      GridTask task;
+      task.nbCluster_   = v_nbCluster_[k];
+      task.freeProp_    = !sameProp;
+      task.p_composer_  = 0;
+      task.criterion_   = Arithmetic<Real>::max();
+      task.failed_      = false;
+      v_tasks.push_back(task);
     }
-    // release
-    delete p_criterion;
+    // estimate all the models, p_composer_ is the best model
+    runGrid(v_tasks, nbSample, criter);
     // get parameters
     for (int l=0; l <s4_list.size(); ++l)
     {
@@ -286,13 +249,156 @@ Real ClusterLauncher::selectBestMixedModel()
   }
   catch (Exception const& e)
   {
-    if (p_current) delete p_current;
-    if (p_criterion) delete p_criterion;
     ::Rf_error(e.error().c_str()) ;
   }
   // failed
   return Arithmetic<Real>::max();
 }
 
+/* Estimate all the tasks of the grid and keep the best composer */
+int ClusterLauncher::runGrid( std::vector<GridTask>& v_tasks, int nbSample, Real& critValue)
+{
+  const int nbTask = v_tasks.size(), nbBatch = nbGridThread();
+  int best = -1;
+  String msg_failed;
+  // each task draws its random numbers in its own stream, so that the
+  // result does not depend on the number of threads. The seed is drawn
+  // from the R generator by the main thread.
+  const uint64_t seed = Law::randSeed();
+  for (int first = 0; first < nbTask; first += nbBatch)
+  {
+    const int last = std::min(first + nbBatch, nbTask);
+    // create the composers and the strategies. The R objects are used,
+    // so this part is performed by the main thread
+    std::vector<ClusterFacade*> v_facades(last - first, (ClusterFacade*)0);
+    // each task is profiled in its own profiler
+    std::vector<Profiler> v_profilers(isProfiled_ ? last - first : 0);
+    for (int t = first; t < last; ++t)
+    {
+      GridTask& task = v_tasks[t];
+      if (task.freeProp_) { task.p_composer_ = new MixtureComposer(nbSample, task.nbCluster_);}
+      else                { task.p_composer_ = new MixtureComposerFixedProp(nbSample, task.nbCluster_);}
+      if (isProfiled_) { task.p_composer_->setProfiler(&v_profilers[t - first]);}
+      // create the mixture(s) and register them
+      if (task.idData_.empty()) { createMixtures(task.p_composer_);}
+      else                      { createMixture(task.p_composer_, task.idData_);}
+      v_facades[t - first] = new ClusterFacade(task.p_composer_);
+      v_facades[t - first]->createFullStrategy(s4_strategy_);
+    }
+    // run the estimations and compute the criteria
+    int t;
+#ifdef _OPENMP
+#pragma omp parallel for schedule(dynamic) if (nbBatch > 1)
+#endif
+    for (t = first; t < last; ++t)
+    {
+      GridTask& task = v_tasks[t];
+      IMixtureCriterion* p_criterion = 0;
+      RandStream stream(seed, t);
+      Law::StreamScope scope(stream);
+      try
+      {
+        if (!v_facades[t - first]->run()) { task.msg_error_ = v_facades[t - first]->error();}
+        p_criterion = Clust::createCriterion(criterion_);
+        p_criterion->setModel(task.p_composer_);
+        p_criterion->run();
+        task.criterion_ = p_criterion->value();
+      }
+      // no exception can leave the parallel region
+      catch (Exception const& e)
+      {
+        task.msg_error_ = e.error();
+        task.failed_ = true;
+      }
+      catch (std::exception const& e)
+      {
+        task.msg_error_ = e.what();
+        task.failed_ = true;
+      }
+      catch (...)
+      {
+        task.msg_error_ = STKERROR_NO_ARG(ClusterLauncher::runGrid,unknown error\n);
+        task.failed_ = true;
+      }
+      if (p_criterion) { delete p_criterion;}
+    }
+    // update the best model following the order of the grid
+    for (t = first; t < last; ++t)
+    {
+      GridTask& task = v_tasks[t];
+      delete v_facades[t - first];
+      if (task.failed_) { msg_failed += task.msg_error_;}
+      else
+      {
+        msg_error_ += task.msg_error_;
+        if (critValue > task.criterion_)
+        {
+          critValue = task.criterion_;
+          std::swap(p_composer_, task.p_composer_);
+          best = t;
+          if (isProfiled_)
+          {
+            profiler_ = v_profilers[t - first];
+            p_composer_->setProfiler(&profiler_);
+          }
+        }
+      }
+      // release current composer
+      if (task.p_composer_) { delete task.p_composer_; task.p_composer_ = 0;}
+    }
+    if (!msg_failed.empty()) { throw Exception(msg_failed);}
+  }
+  return best;
+}
+
+/* @return true if the R option MixAll.profile is set to TRUE */
+bool ClusterLauncher::isProfilingEnabled()
+{
+  SEXP option = Rf_GetOption1(Rf_install("MixAll.profile"));
+  return (option != R_NilValue) && Rcpp::as<bool>(option);
+}
+
+/* @return the report of profiler_ as a R list */
+Rcpp::List ClusterLauncher::profileToList() const
+{
+  Profiler::Entries const& entries = profiler_.entries();
+  CharacterVector name(entries.size());
+  NumericVector time(entries.size());
+  IntegerVector nbCall(entries.size());
+  int l = 0;
+  for (Profiler::Entries::const_iterator it = entries.begin(); it != entries.end(); ++it, ++l)
+  {
+    name[l]   = it->first;
+    time[l]   = it->second.time_;
+    nbCall[l] = it->second.nbCall_;
+  }
+  Profiler::Series const& series = profiler_.series();
+  Rcpp::List traces(series.size());
+  CharacterVector traceNames(series.size());
+  l = 0;
+  for (Profiler::Series::const_iterator it = series.begin(); it != series.end(); ++it, ++l)
+  {
+    traceNames[l] = it->first;
+    traces[l]     = Rcpp::wrap(it->second);
+  }
+  traces.attr("names") = traceNames;
+  return Rcpp::List::create( Rcpp::Named("sections") = DataFrame::create( Rcpp::Named("name") = name
+                                                                        , Rcpp::Named("time") = time
+                                                                        , Rcpp::Named("nbCall") = nbCall
+                                                                        , Rcpp::Named("stringsAsFactors") = false)
+                           , Rcpp::Named("series") = traces);
+}
+
+/* @return the number of tasks of the grid estimated concurrently */
+int ClusterLauncher::nbGridThread() const
+{
+  // the random numbers of the tasks are drawn in their own RandStream
+#ifdef _OPENMP
+  return omp_get_max_threads();
+#else
+  return 1;
+#endif
+}
+
 } // namespace STK
 
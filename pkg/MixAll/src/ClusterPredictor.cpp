@@ -50,6 +50,15 @@ bool ClusterPredictor::run()
   Clust::MixtureClass classModel = Clust::mixtureToMixtureClass(model);
   String idData                  = Clust::mixtureToString(model);
 
+  // without missing values the prediction is given by the Bayes classifier:
+  // score the samples directly with the estimated parameters
+  {
+    RVector<double> pk((SEXP)s4_model_.slot("pk"));
+    MixtureScorer scorer(pk);
+    if (addScorer(scorer, s4_component_, (SEXP)s4_clusterPredict_.slot("data")))
+    { return runScorer(scorer);}
+  }
+
   // put data set to data handler
   int nbSample;
   if ((classModel == Clust::Categorical_)||(classModel == Clust::Poisson_))
@@ -66,7 +75,8 @@ bool ClusterPredictor::run()
   }
   // create composer and mixtures
   int nbCluster = s4_model_.slot("nbCluster");
-  p_composer_ = new MixtureComposer(nbSample, nbCluster);
+  // the proportions of the model are not re-estimated during the prediction
+  p_composer_ = new MixtureComposerFixedProp(nbSample, nbCluster);
   createMixtures(p_composer_);
 
 #ifdef STK_MIXTURE_VERBOSE
@@ -48,6 +48,20 @@ bool ClusterPredictorMixedData::run()
 {
   int nbSample = s4_clusterPredict_.slot("nbSample");
 
+  // without missing values the prediction is given by the Bayes classifier:
+  // score the samples directly with the estimated parameters
+  {
+    RVector<double> pk((SEXP)s4_model_.slot("pk"));
+    MixtureScorer scorer(pk);
+    bool isScorable = true;
+    for(int l=0; l<lcomponent_.length() && isScorable; ++l)
+    {
+      Rcpp::S4 s4_component = lcomponent_[l];
+      isScorable = addScorer(scorer, s4_component, (SEXP)ldata_[l]);
+    }
+    if (isScorable) { return runScorer(scorer);}
+  }
+
   // put data set to data handler
   for(int l=0; l<lcomponent_.length(); ++l)
   {
@@ -80,7 +94,8 @@ bool ClusterPredictorMixedData::run()
 
   // create composer and mixtures
   int nbCluster = s4_model_.slot("nbCluster");
-  p_composer_ = new MixtureComposer(nbSample, nbCluster);
+  // the proportions of the model are not re-estimated during the prediction
+  p_composer_ = new MixtureComposerFixedProp(nbSample, nbCluster);
   createMixtures(p_composer_);
 
   // set proportions parameters of the predictor
@@ -42,6 +42,7 @@ IClusterPredictor::IClusterPredictor( Rcpp::S4 s4_model,  Rcpp::S4 s4_clusterPre
                                   , s4_algo_(s4_clusterPredict_.slot("algo"))
                                   , p_algo_(createAlgo())
                                   , p_composer_(0)
+                                  , lRealData_(), lIntData_()
 {}
 IClusterPredictor::~IClusterPredictor()
 { if (p_algo_) delete p_algo_;
@@ -151,5 +152,103 @@ void IClusterPredictor::getMissingValues(Clust::MixtureClass const& classModel,
   }
 }
 
+/* Add the scorer of a component to a MixtureScorer */
+bool IClusterPredictor::addScorer( MixtureScorer& scorer, Rcpp::S4 s4_component, SEXP r_data)
+{
+  String idModel                 = s4_component.slot("modelName");
+  Clust::Mixture model           = Clust::stringToMixture(idModel);
+  Clust::MixtureClass classModel = Clust::mixtureToMixtureClass(model);
+  String idData                  = Clust::mixtureToString(model);
+  int nbCluster = scorer.nbCluster();
+  switch (classModel)
+  {
+    case Clust::DiagGaussian_:
+    case Clust::Gamma_:
+    {
+      RMatrix<Real> data(r_data);
+      if (data.nbAvailableValues() != data.sizeRows()*data.sizeCols()) return false;
+      lRealData_.push_back(data);
+      ArrayXX params;
+      params.move(getParameters(idData, s4_component));
+      if (classModel == Clust::DiagGaussian_)
+      {
+        DiagGaussianScorer< RMatrix<Real> >* p_scorer = new DiagGaussianScorer< RMatrix<Real> >(params, nbCluster);
+        p_scorer->setData(lRealData_.back());
+        scorer.registerScorer(p_scorer);
+      }
+      else
+      {
+        GammaScorer< RMatrix<Real> >* p_scorer = new GammaScorer< RMatrix<Real> >(params, nbCluster);
+        p_scorer->setData(lRealData_.back());
+        scorer.registerScorer(p_scorer);
+      }
+    }
+    return true;
+    case Clust::Poisson_:
+    case Clust::Categorical_:
+    {
+      RMatrix<Integer> data(r_data);
+      if (classModel == Clust::Categorical_) { checkModalities(s4_component, data);}
+      if (data.nbAvailableValues() != data.sizeRows()*data.sizeCols()) return false;
+      lIntData_.push_back(data);
+      ArrayXX params;
+      params.move(getParameters(idData, s4_component));
+      if (classModel == Clust::Poisson_)
+      {
+        PoissonScorer< RMatrix<Integer> >* p_scorer = new PoissonScorer< RMatrix<Integer> >(params, nbCluster);
+        p_scorer->setData(lIntData_.back());
+        scorer.registerScorer(p_scorer);
+      }
+      else
+      { // the modalities are the codes 1..nbModalities of the R factors
+        CategoricalScorer< RMatrix<Integer> >* p_scorer
+          = new CategoricalScorer< RMatrix<Integer> >(params, nbCluster, 1);
+        p_scorer->setData(lIntData_.back());
+        scorer.registerScorer(p_scorer);
+      }
+    }
+    return true;
+    default:
+      break;
+  }
+  return false;
+}
+
+/* check that the categorical data are coded by the modalities of the model */
+void IClusterPredictor::checkModalities( Rcpp::S4 s4_component, RMatrix<Integer> const& data) const
+{
+  int nbModalities = s4_component.slot("nbModalities");
+  for (int j=data.beginCols(); j<data.endCols(); ++j)
+  {
+    for (int i=data.beginRows(); i<data.endRows(); ++i)
+    {
+      Integer value = data(i,j);
+      if (Arithmetic<Integer>::isNA(value)) continue;
+      if (value < 1 || value > nbModalities)
+      { STKRUNTIME_ERROR_1ARG(IClusterPredictor::checkModalities,value,modality not in the model);}
+    }
+  }
+}
+
+/* score the data sets and set the results to the R side */
+bool IClusterPredictor::runScorer( MixtureScorer& scorer)
+{
+  if (!scorer.run())
+  {
+    msg_error_ = scorer.error();
+    return false;
+  }
+  s4_clusterPredict_.slot("pk")  = s4_model_.slot("pk");
+  s4_clusterPredict_.slot("tik") = Rcpp::wrap(scorer.tik());
+  s4_clusterPredict_.slot("zi")  = Rcpp::wrap(scorer.zi());
+  Rcpp::NumericVector fi = s4_clusterPredict_.slot("lnFi");
+  Rcpp::IntegerVector zi = s4_clusterPredict_.slot("zi");
+  for (int i=0; i< fi.length(); ++i)
+  {
+    fi[i] = scorer.lnFi()[baseIdx + i];
+    zi[i] += (1 - baseIdx);  // set base 1 for the class labels
+  }
+  return true;
+}
 
 } // namespace SK
@@ -91,5 +91,15 @@ void ILauncher::createMixtures(IMixtureStatModel* p_model)
   p_model->createMixture(categoricalManager_);
 }
 
+/* create the mixture associated to idData in the given model */
+IMixture* ILauncher::createMixture(IMixtureStatModel* p_model, String const& idData)
+{
+  IMixture* p_mixture = p_model->createMixture(diagGaussianManager_, idData);
+  if (!p_mixture) { p_mixture = p_model->createMixture(poissonManager_, idData);}
+  if (!p_mixture) { p_mixture = p_model->createMixture(gammaManager_, idData);}
+  if (!p_mixture) { p_mixture = p_model->createMixture(categoricalManager_, idData);}
+  return p_mixture;
+}
+
 } // namespace STK
 
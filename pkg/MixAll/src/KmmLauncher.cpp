@@ -109,6 +109,8 @@ Kernel::IKernel* KmmLauncher::createKernel(Rcpp::S4 s4_component, String const&
   String              kernelName        = Rcpp::as<String>(s4_component.slot("kernelName"));
   Rcpp::NumericVector kernelParameters  = s4_component.slot("kernelParameters");
   bool                kernelComputation = Rcpp::as<bool>(s4_component.slot("kernelComputation"));
+  int                 nbLandmark        = s4_component.hasSlot("nbLandmark")
+                                          ? Rcpp::as<int>(s4_component.slot("nbLandmark")) : 0;
 
   Kernel::IKernel* p_kernel = 0;
   // build kernel
@@ -187,8 +189,16 @@ Kernel::IKernel* KmmLauncher::createKernel(Rcpp::S4 s4_component, String const&
       return 0;
       break;
   }
-  // compute Gram matrix
-  if (kernelComputation)
+  // compute the low rank feature map (Nystrom approximation) or the Gram matrix
+  if (nbLandmark > 0 && nbLandmark < p_kernel->nbSample())
+  {
+    if (!p_kernel->computeFeatures(nbLandmark))
+    {
+      delete p_kernel;
+      return 0;
+    }
+  }
+  else if (kernelComputation)
   {
     p_kernel->run();
     s4_component.slot("gram") = STK::wrap(p_kernel->gram());
@@ -52,6 +52,7 @@
  * @li GramSchmidt orthogonalization of the columns of a matrix/array
  * @li Householder rotations of an array/matrix.
  * @li Cholesky decomposition.
+ * @li streaming accumulation and resolution of the normal equations.
  *
  **/
 
@@ -80,6 +81,7 @@
 #include <Algebra/include/STK_Svd.h>
 #include <Algebra/include/STK_SymEigen.h>
 #include <Algebra/include/STK_MultiLeastSquare.h>
+#include <Algebra/include/STK_NormalEquations.h>
 
 /* lapack */
 #include <Algebra/include/STK_lapack_Qr.h>
@@ -99,6 +99,7 @@
 #include <DManager/include/STK_ExportToCsv.h>
 #include <DManager/include/STK_DataFrameToArray2D.h>
 #include <DManager/include/STK_CsvToArray.h>
+#include <DManager/include/STK_ReadCsvToArray.h>
 
 /* HeapSort utilities. */
 #include <DManager/include/STK_HeapSort.h>
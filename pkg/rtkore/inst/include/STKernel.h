@@ -80,5 +80,7 @@
 #include <STKernel/include/STK_Misc.h>
 /* Chrono functions.  */
 #include <STKernel/include/STK_Chrono.h>
+/* Wall-clock profiling. */
+#include <STKernel/include/STK_Profiler.h>
 
 #endif  /* STKERNEL_H */
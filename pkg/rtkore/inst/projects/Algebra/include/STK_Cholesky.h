@@ -36,6 +36,8 @@
 #ifndef STK_CHOLESKY_H
 #define STK_CHOLESKY_H
 
+#include <algorithm>
+
 #include <Sdk.h>
 
 #include <Arrays/include/STK_Array2DDiagonal.h>
@@ -88,6 +90,76 @@ bool cholesky( ExprBase<Lhs> const& A
   return nozero;
 }
 
+/** @ingroup Algebra
+ *  @brief Compute in place the LDL decomposition of a symmetric band matrix.
+ *  The matrix is stored by diagonals: if the columns of @c band are
+ *  @c b0:b0+w then <tt>band(i, b0+d)</tt> is \f$ A_{i,i-d} \f$ for
+ *  \f$ 0 \leq d \leq w \f$. On exit <tt>band(i, b0)</tt> contains
+ *  \f$ D_{ii}\f$ and <tt>band(i, b0+d)</tt> contains \f$ L_{i,i-d} \f$ for d>0.
+ *  The cost is \f$ O(n w^2) \f$ instead of \f$ O(n^3) \f$.
+ * @param band the lower part of the symmetric band matrix to decompose
+ * @return @c true if no error, @c false otherwise (results are misleading)
+ * @sa bandCholeskySolve
+ */
+template < class Band>
+bool bandCholesky( Band& band)
+{
+  typedef typename Band::Type Type;
+  const int b0 = band.beginCols(), w = band.sizeCols()-1;
+  const int first = band.beginRows(), last = band.lastIdxRows();
+  bool nozero = true;
+  for (int j=first; j<=last; ++j )
+  {
+    Type sum1 = band(j, b0);
+    for (int k=std::max(first, j-w); k<j; ++k)
+    { sum1 -= band(j, b0+j-k) * band(j, b0+j-k) * band(k, b0);}
+    band(j, b0) = sum1;
+    nozero &= (sum1!=0);
+    for (int i=j+1; i<=std::min(last, j+w); ++i)
+    {
+      Type sum2 = band(i, b0+i-j);
+      for (int k=std::max(first, i-w); k<j; ++k)
+      { sum2 -= band(i, b0+i-k) * band(j, b0+j-k) * band(k, b0);}
+      band(i, b0+i-j) = sum1 ? sum2/sum1 : sum2;
+    }
+  }
+  return nozero;
+}
+
+/** @ingroup Algebra
+ *  @brief Solve in place the linear system \f$ \mathbf{LDL}^{*}X = B \f$
+ *  using the decomposition computed by bandCholesky.
+ * @param band the decomposition computed by bandCholesky
+ * @param b the right hand side, overwritten by the solution
+ * @sa bandCholesky
+ */
+template < class Band, class Rhs>
+void bandCholeskySolve( Band const& band, Rhs& b)
+{
+  typedef typename Band::Type Type;
+  const int b0 = band.beginCols(), w = band.sizeCols()-1;
+  const int first = band.beginRows(), last = band.lastIdxRows();
+  if (b.rows() != band.rows())
+  { STKRUNTIME_ERROR_NO_ARG(bandCholeskySolve,b.rows() != band.rows());}
+  for (int l=b.beginCols(); l<b.endCols(); ++l)
+  {
+    // solve L z = b and D u = z
+    for (int i=first; i<=last; ++i)
+    {
+      Type sum = b(i, l);
+      for (int k=std::max(first, i-w); k<i; ++k) { sum -= band(i, b0+i-k) * b(k, l);}
+      b(i, l) = sum;
+    }
+    for (int i=first; i<=last; ++i) { b(i, l) /= band(i, b0);}
+    // solve L' x = u
+    for (int i=last; i>=first; --i)
+    {
+      Type sum = b(i, l);
+      for (int k=i+1; k<=std::min(last, i+w); ++k) { sum -= band(k, b0+k-i) * b(k, l);}
+      b(i, l) = sum;
+    }
+  }
+}
 
 } // namespace STK
 
@@ -0,0 +1,304 @@
+/*--------------------------------------------------------------------*/
+/*     Copyright (C) 2004-2017  Serge Iovleff, Université Lille 1, Inria
+
+    This program is free software; you can redistribute it and/or modify
+    it under the terms of the GNU Lesser General Public License as
+    published by the Free Software Foundation; either version 2 of the
+    License, or (at your option) any later version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU Lesser General Public License for more details.
+
+    You should have received a copy of the GNU Lesser General Public
+    License along with this program; if not, write to the
+    Free Software Foundation, Inc.,
+    59 Temple Place,
+    Suite 330,
+    Boston, MA 02111-1307
+    USA
+
+    Contact : S..._Dot_I..._At_stkpp_Dot_org (see copyright for ...)
+*/
+
+/*
+ * Project:  stkpp::Algebra
+ * Purpose:  Streaming accumulation and resolution of the normal equations.
+ * Author:   iovleff, S..._Dot_I..._At_stkpp_Dot_org (see copyright for ...)
+ **/
+
+/** @file STK_NormalEquations.h
+ *  @brief In this file we define the NormalEquations class.
+ **/
+
+#ifndef STK_NORMALEQUATIONS_H
+#define STK_NORMALEQUATIONS_H
+
+#include <algorithm>
+#include <cmath>
+
+#include <Sdk.h>
+
+#include <Arrays/include/STK_Array1D.h>
+#include <Arrays/include/STK_Array2D.h>
+#include <Arrays/include/STK_Array2DSquare.h>
+#include <Arrays/include/STK_CArray.h>
+#include <STatistiK/include/STK_Stat_Covariance.h>
+
+#include "STK_Cholesky.h"
+
+namespace STK
+{
+
+namespace hidden
+{
+/** @ingroup hidden
+ *  @brief unit weights used by the unweighted accumulation of the
+ *  NormalEquations class.
+ **/
+struct UnitWeights
+{
+  inline Real operator[](int) const { return Real(1);}
+};
+
+} // namespace hidden
+
+/** @ingroup Algebra
+ *  @brief The NormalEquations class accumulates the cross products
+ *  \f$ X'WX \f$ and \f$ X'WY \f$ of a (weighted) least square problem
+ *  \f[ \min_{\beta} \|Y - X\beta\|_W^2 \f]
+ *  and solve the normal equations \f$ X'WX\beta = X'WY \f$ using the
+ *  LDL' decomposition of \f$ X'WX \f$.
+ *
+ *  The samples can be added (or removed) by chunks of rows, so that the whole
+ *  data set never needs to be in memory and a model can be refitted when new
+ *  rows are appended. Inside a chunk the rows are split in at most maxChunk_
+ *  blocks accumulated in parallel and summed in the order of the blocks, thus
+ *  the results do not depend on the number of threads. The products of a
+ *  block are computed by the cross-product and product kernels.
+ *  @code
+ *    NormalEquations eq(x.cols(), y.cols());
+ *    eq.add(x1, y1); eq.add(x2, y2);
+ *    ArrayXX coefs;
+ *    if (!eq.solve(coefs)) { ... } // X'X is singular
+ *  @endcode
+ **/
+class NormalEquations
+{
+  public:
+    enum
+    {
+      /** minimal number of rows of a block */
+      blockSize_ = 256,
+      /** maximal number of blocks of a chunk */
+      maxChunk_ = 16
+    };
+    /** default constructor. The dimensions are set by the first chunk. */
+    inline NormalEquations(): xtx_(), xty_(), nbSample_(0), sumWeights_(0.) {}
+    /** constructor
+     *  @param xcols,ycols the columns of the co-variates and of the responses
+     **/
+    inline NormalEquations( Range const& xcols, Range const& ycols)
+                          : xtx_(xcols, Real(0)), xty_(xcols, ycols, Real(0))
+                          , nbSample_(0), sumWeights_(0.)
+    {}
+    /** @return the matrix \f$ X'WX \f$ */
+    inline ArraySquareX const& xtx() const { return xtx_;}
+    /** @return the matrix \f$ X'WY \f$ */
+    inline ArrayXX const& xty() const { return xty_;}
+    /** @return the number of samples accumulated */
+    inline int nbSample() const { return nbSample_;}
+    /** @return the sum of the weights of the samples accumulated */
+    inline Real sumWeights() const { return sumWeights_;}
+
+    /** remove all the samples accumulated
+     *  @param xcols,ycols the columns of the co-variates and of the responses
+     **/
+    inline void clear( Range const& xcols, Range const& ycols)
+    {
+      xtx_.resize(xcols) = Real(0);
+      xty_.resize(xcols, ycols) = Real(0);
+      nbSample_ = 0; sumWeights_ = 0.;
+    }
+    /** add a chunk of samples
+     *  @param x,y the co-variates and the responses of the samples
+     **/
+    template<class ArrayX, class ArrayY>
+    inline void add( ExprBase<ArrayX> const& x, ExprBase<ArrayY> const& y)
+    { update(x, y, hidden::UnitWeights(), Real(1));}
+    /** add a chunk of weighted samples
+     *  @param x,y the co-variates and the responses of the samples
+     *  @param weights the weights of the samples
+     **/
+    template<class ArrayX, class ArrayY, class Weights>
+    inline void add( ExprBase<ArrayX> const& x, ExprBase<ArrayY> const& y
+                   , Weights const& weights)
+    { update(x, y, weights, Real(1));}
+    /** remove a chunk of samples previously added
+     *  @param x,y the co-variates and the responses of the samples
+     **/
+    template<class ArrayX, class ArrayY>
+    inline void remove( ExprBase<ArrayX> const& x, ExprBase<ArrayY> const& y)
+    { update(x, y, hidden::UnitWeights(), Real(-1));}
+    /** remove a chunk of weighted samples previously added
+     *  @param x,y the co-variates and the responses of the samples
+     *  @param weights the weights of the samples
+     **/
+    template<class ArrayX, class ArrayY, class Weights>
+    inline void remove( ExprBase<ArrayX> const& x, ExprBase<ArrayY> const& y
+                      , Weights const& weights)
+    { update(x, y, weights, Real(-1));}
+    /** add the samples accumulated by an other instance
+     *  @param other the normal equations to merge
+     **/
+    void merge(NormalEquations const& other)
+    {
+      if (other.nbSample_ == 0) return;
+      if (nbSample_ == 0 && xtx_.empty()) { clear(other.xtx_.cols(), other.xty_.cols());}
+      if (other.xtx_.cols() != xtx_.cols() || other.xty_.cols() != xty_.cols())
+      { STKRUNTIME_ERROR_NO_ARG(NormalEquations::merge,dimensions mismatch);}
+      xtx_ += other.xtx_;
+      xty_ += other.xty_;
+      nbSample_ += other.nbSample_;
+      sumWeights_ += other.sumWeights_;
+    }
+    /** solve the normal equations using the LDL' decomposition of X'WX.
+     *  @param coefs the solution \f$ \beta = (X'WX)^{-1}X'WY \f$
+     *  @return @c false if X'WX is singular, @c true otherwise
+     **/
+    bool solve(ArrayXX& coefs) const
+    {
+      Array2DDiagonal<Real> D;
+      Array2DLowerTriangular<Real> L;
+      if (!cholesky(xtx_, D, L)) return false;
+      Range xcols = xtx_.cols();
+      coefs.resize(xcols, xty_.cols());
+      for (int l = xty_.beginCols(); l < xty_.endCols(); ++l)
+      {
+        // solve L z = b and D u = z
+        for (int j = xcols.begin(); j < xcols.end(); ++j)
+        {
+          Real sum = xty_(j, l);
+          for (int k = xcols.begin(); k < j; ++k) { sum -= L(j, k) * coefs(k, l);}
+          coefs(j, l) = sum;
+        }
+        for (int j = xcols.begin(); j < xcols.end(); ++j) { coefs(j, l) /= D[j];}
+        // solve L' c = u
+        for (int j = xcols.lastIdx(); j >= xcols.begin(); --j)
+        {
+          Real sum = coefs(j, l);
+          for (int k = j+1; k < xcols.end(); ++k) { sum -= L(k, j) * coefs(k, l);}
+          coefs(j, l) = sum;
+        }
+      }
+      return true;
+    }
+
+  private:
+    /** the matrix X'WX */
+    ArraySquareX xtx_;
+    /** the matrix X'WY */
+    ArrayXX xty_;
+    /** number of samples */
+    int nbSample_;
+    /** sum of the weights */
+    Real sumWeights_;
+
+    /** compute the products \f$ X'WX \f$ and \f$ X'WY \f$ of the rows
+     *  [begin, end) of a chunk. The rows are copied in contiguous arrays so
+     *  that the products are computed by the cross-product kernel (syrk) and
+     *  the product kernels (gemm or packed products). If the weights are not
+     *  negative, the rows are scaled by the square root of the weights and
+     *  only the symmetric product is computed.
+     *  @param x,y the co-variates and the responses of the samples
+     *  @param weights the weights of the samples
+     *  @param begin,end the rows of the block
+     *  @param pxtx,pxty the products, with ranges starting at 0
+     *  @param sw the sum of the weights of the block
+     **/
+    template<class ArrayX, class ArrayY, class Weights>
+    static void blockProducts( ExprBase<ArrayX> const& x, ExprBase<ArrayY> const& y
+                             , Weights const& weights, int begin, int end
+                             , CArrayXX& pxtx, CArrayXX& pxty, Real& sw)
+    {
+      const int m = end - begin, d = x.sizeCols(), q = y.sizeCols();
+      const int j0 = x.beginCols(), l0 = y.beginCols();
+      bool positive = true;
+      sw = 0.;
+      for (int i = begin; i < end; ++i) { sw += weights[i]; positive &= (weights[i] >= 0.);}
+      CArrayXX xb(m, d), yb(m, q);
+      if (positive)
+      {
+        for (int i = begin; i < end; ++i)
+        {
+          const Real s = std::sqrt(Real(weights[i]));
+          for (int j = 0; j < d; ++j) { xb(i-begin, j) = s * x.elt(i, j0+j);}
+          for (int l = 0; l < q; ++l) { yb(i-begin, l) = s * y.elt(i, l0+l);}
+        }
+        hidden::CrossProduct::run(xb, pxtx);
+        pxty = xb.transpose() * yb;
+      }
+      else
+      {
+        CArrayXX xwb(m, d);
+        for (int i = begin; i < end; ++i)
+        {
+          const Real w = weights[i];
+          for (int j = 0; j < d; ++j) { xwb(i-begin, j) = w * (xb(i-begin, j) = x.elt(i, j0+j));}
+          for (int l = 0; l < q; ++l) { yb(i-begin, l) = y.elt(i, l0+l);}
+        }
+        pxtx = xwb.transpose() * xb;
+        pxty = xwb.transpose() * yb;
+      }
+    }
+    /** add (sign = 1) or remove (sign = -1) a chunk of samples
+     *  @param x,y the co-variates and the responses of the samples
+     *  @param weights the weights of the samples
+     *  @param sign sign of the update
+     **/
+    template<class ArrayX, class ArrayY, class Weights>
+    void update( ExprBase<ArrayX> const& x, ExprBase<ArrayY> const& y
+               , Weights const& weights, Real sign)
+    {
+      if (x.rows() != y.rows())
+      { STKRUNTIME_ERROR_NO_ARG(NormalEquations::update,x and y must have the same rows);}
+      if (nbSample_ == 0 && xtx_.empty()) { clear(x.cols(), y.cols());}
+      if (x.cols() != xtx_.cols() || y.cols() != xty_.cols())
+      { STKRUNTIME_ERROR_NO_ARG(NormalEquations::update,dimensions mismatch);}
+      Range rows = x.rows();
+      if (rows.size() <= 0) return;
+      // split the rows in nbBlock blocks (depend only on the number of rows)
+      const int nbBlock = std::min(int(maxChunk_), (rows.size() + blockSize_ - 1)/blockSize_);
+      const int size = (rows.size() + nbBlock - 1)/nbBlock;
+      Range xcols = x.cols(), ycols = y.cols();
+      Array1D<CArrayXX> xtxs(nbBlock), xtys(nbBlock);
+      Array1D<Real> sws(nbBlock);
+#ifdef _OPENMP
+#pragma omp parallel for schedule(static)
+#endif
+      for (int b = 0; b < nbBlock; ++b)
+      {
+        int begin = rows.begin() + b * size;
+        int end   = std::min(begin + size, rows.end());
+        blockProducts( x, y, weights, begin, end
+                     , xtxs[xtxs.begin() + b], xtys[xtys.begin() + b], sws[sws.begin() + b]);
+      }
+      // sum the blocks in a fixed order
+      const int j0 = xcols.begin(), l0 = ycols.begin();
+      for (int b = xtxs.begin(); b < xtxs.end(); ++b)
+      {
+        for (int j = xcols.begin(); j < xcols.end(); ++j)
+        {
+          for (int k = xcols.begin(); k < xcols.end(); ++k) { xtx_(j, k) += sign * xtxs[b](j-j0, k-j0);}
+          for (int l = ycols.begin(); l < ycols.end(); ++l) { xty_(j, l) += sign * xtys[b](j-j0, l-l0);}
+        }
+        sumWeights_ += sign * sws[b];
+      }
+      nbSample_ += (sign > 0) ? rows.size() : -rows.size();
+    }
+};
+
+} // namespace STK
+
+#endif /* STK_NORMALEQUATIONS_H */
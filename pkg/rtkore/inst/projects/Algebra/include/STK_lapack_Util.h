@@ -60,6 +60,10 @@ extern int sgelsd_( int *m, int *n, int *nrhs
                   , float *a, int *lda, float *b, int *ldb, float *s, float *rcond
                   , int *rank, float *work, int *lWork
                   , int *iwork, int *info);
+/** BLAS routine in float computing a symmetric rank-k update */
+extern void ssyrk_( char *uplo, char *trans, int *n, int *k
+                  , float *alpha, float *a, int *lda
+                  , float *beta, float *c, int *ldc);
 
 #else /* double */
 
@@ -77,6 +81,10 @@ extern int dgelsd_( int *m, int *n, int *nrhs
                   , double *a, int *lda, double *b, int *ldb, double *s, double *rcond
                   , int *rank, double *work, int *lWork
                   , int *iwork, int *info);
+/** BLAS routine in double computing a symmetric rank-k update */
+extern void dsyrk_( char *uplo, char *trans, int *n, int *k
+                  , double *alpha, double *a, int *lda
+                  , double *beta, double *c, int *ldc);
 
 #endif
 
@@ -626,6 +634,36 @@ inline int syevr( char jobz, char range, char uplo
   return info;
 }
 
+/** @ingroup Algebra
+ *  @brief wrapper of the BLAS SYRK routine: performs the symmetric rank-k
+ *  update <em> C = alpha A A^T + beta C </em> or
+ *  <em> C = alpha A^T A + beta C </em>.
+ *
+ *  @param[in] uplo 'U' if the upper part of C is referenced and updated,
+ *  'L' if it is the lower part.
+ *  @param[in] trans 'N' for A A^T, 'T' for A^T A.
+ *  @param[in] n the order of the matrix C.
+ *  @param[in] k the number of columns of A if trans is 'N', the number of
+ *  rows of A otherwise.
+ *  @param[in] alpha,beta the scalars
+ *  @param[in] a the matrix A (column oriented)
+ *  @param[in] lda the leading dimension of A
+ *  @param[in,out] c the matrix C (column oriented)
+ *  @param[in] ldc the leading dimension of C
+ **/
+inline void syrk( char uplo, char trans, int n, int k
+                , Real alpha, Real const* a, int lda
+                , Real beta, Real* c, int ldc)
+{
+#ifdef STKUSELAPACK
+#ifdef STKREALAREFLOAT
+  ssyrk_(&uplo, &trans, &n, &k, &alpha, const_cast<Real*>(a), &lda, &beta, c, &ldc);
+#else
+  dsyrk_(&uplo, &trans, &n, &k, &alpha, const_cast<Real*>(a), &lda, &beta, c, &ldc);
+#endif
+#endif
+}
+
 } // namespace lapack
 
 } // namespace STK
@@ -541,6 +541,14 @@ class ExprBase: public ITContainer<Derived, hidden::Traits<Derived>::structure_>
     template<int Size_>
     inline SubOperator<Derived, Size_, sizeCols_> const row(TRange<Size_> const& I) const
     { return SubOperator<Derived, Size_, sizeCols_> (this->asDerived(), I, this->cols());}
+    /** @return the rows of this with indexes @c idx. The data are not copied.
+     *  @param idx the indexes of the rows to select, they have to outlive
+     *  the returned expression
+     *  @sa RowSelectOperator
+     **/
+    template<class Indexes>
+    inline RowSelectOperator<Derived, Indexes> const selectRows(Indexes const& idx) const
+    { return RowSelectOperator<Derived, Indexes> (this->asDerived(), idx);}
 
     /** @return the sub-array(I,J) of this. */
     template<int SizeRows_, int SizeCols_>
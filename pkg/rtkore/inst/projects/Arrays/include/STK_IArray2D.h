@@ -114,6 +114,25 @@ class IArray2D: protected IContainer2D<hidden::Traits<Derived>::sizeRows_, hidde
     typedef MemAllocator<PtrCol, sizeCols_> Allocator;
     /** type of the Base Container Class. */
     typedef ArrayBase<Derived> Base;
+    /** Type of the block of memory storing the columns in contiguous mode. */
+    typedef MemAllocator<Type, UnknownSize> Slab;
+
+    enum
+    {
+      /** @c true if the columns can be stored in a single block of memory
+       *  (only the general and square arrays can be contiguous) */
+      contiguousStructure_ = (int)structure_ == (int)Arrays::array2D_
+                          || (int)structure_ == (int)Arrays::square_,
+      /** @c true if the columns are stored by default in a single block of memory */
+      contiguousDefault_ =
+#ifdef STK_CONTIGUOUS_ARRAY2D
+        contiguousStructure_,
+#else
+        false,
+#endif
+      /** alignment (in number of elements) of the leading dimension */
+      slabAlign_ = (64 % sizeof(Type) == 0) ? int(64/sizeof(Type)) : 1
+    };
 
     using Base::elt;
     using Base2D::setCols;
@@ -217,6 +236,18 @@ class IArray2D: protected IContainer2D<hidden::Traits<Derived>::sizeRows_, hidde
      *  @param col index of the column we want the range
      **/
     inline Range const& rangeCol(int col) const { return rangeCols_[col];}
+    /** @return @c true if the columns are stored in a single block of memory
+     *  with leading dimension ldx() */
+    inline bool isContiguous() const { return contiguous_;}
+    /** @return the leading dimension of the block of memory storing the
+     *  columns, 0 if the columns are allocated separately */
+    inline int ldx() const { return contiguous_ ? ldx_ : 0;}
+    /** Store the columns in a single block of memory (column-major with a
+     *  leading dimension) or in one allocation per column. The data are
+     *  copied in the new storage.
+     *  @param contiguous @c true if the columns have to be stored contiguously
+     **/
+    void setContiguous(bool contiguous);
 
     /** implement setValue for vector/point/diagonal arrays*/
     inline void setValueImpl( int j, TypeConst v) { this->asDerived().setValue1D(j, v);}
@@ -517,7 +548,14 @@ class IArray2D: protected IContainer2D<hidden::Traits<Derived>::sizeRows_, hidde
        if (this->endCols() <= pos2)
        { STKOUT_OF_RANGE_2ARG(IArray2D::swapCols,pos1, pos2,endCols() <=pos2);}
  #endif
-       allocator_.swap(pos1, pos2);
+       // the columns are references on the block of memory (which is empty
+       // if this is a reference): swap the data through the columns
+       if (contiguous_)
+       {
+         PtrCol p1 = allocator_.elt(pos1), p2 = allocator_.elt(pos2);
+         for (int i=beginRows(); i<endRows(); ++i) { std::swap(p1->elt(i), p2->elt(i));}
+       }
+       else { allocator_.swap(pos1, pos2);}
        rangeCols_.swap(pos1,pos2);
      }
      /** swap two elements: only for vectors and points
@@ -531,7 +569,8 @@ class IArray2D: protected IContainer2D<hidden::Traits<Derived>::sizeRows_, hidde
       *  but it is useful to define this method even for constant objects.
       *
       *  @note data in itself are not altered nor duplicated, thus other and
-      *  this possess the same columns.
+      *  this possess the same columns. If this or other is contiguous, the
+      *  columns of other are copied and other is not modified.
       *  @param other the container to merge with this
       **/
      template<class OtherDerived>
@@ -546,7 +585,17 @@ class IArray2D: protected IContainer2D<hidden::Traits<Derived>::sizeRows_, hidde
        if (this->sizeCols() <= 0) setRows(other.rows());
        if (this->rows() != other.rows())
        { STKRUNTIME_ERROR_NO_ARG(IArray2D::merge(other),this->rows() != other.rows());}
-
+       // contiguous storage: copy the columns of other
+       if (contiguous_ || other.contiguous_)
+       {
+         const int first = endCols();
+         insertCols(first, other.sizeCols());
+         for (int j=first, jOther=other.beginCols(); jOther<other.endCols(); ++j, ++jOther)
+         {
+           for (int i=beginRows(); i<endRows(); ++i) { elt(i, j) = other.elt(i, jOther);}
+         }
+         return;
+       }
        // break const reference
        IArray2D< OtherDerived>& Tref = const_cast<IArray2D< OtherDerived>&>(other);
        // compute horizontal range of the container after insertion
@@ -570,7 +619,8 @@ class IArray2D: protected IContainer2D<hidden::Traits<Derived>::sizeRows_, hidde
      /** Append the vector @c other to @c this without copying the data
       *  explicitly. @c other is appended to this and
       *  @c other will become a reference container. The data in itself are not
-      *  altered, the Array1D become a reference on its own data.
+      *  altered, the Array1D become a reference on its own data. If this is
+      *  contiguous, @c other is copied and is not modified.
       *  @param other the container to merge with this
       **/
      template<class OtherDerived>
@@ -585,7 +635,14 @@ class IArray2D: protected IContainer2D<hidden::Traits<Derived>::sizeRows_, hidde
        if (this->sizeCols() <= 0) setRows(other.range());
        if (this->rows() != other.range())
        { STKRUNTIME_ERROR_NO_ARG(IArray2D::merge(IArray1D),this->rows() != other.range());}
-
+       // contiguous storage: copy other
+       if (contiguous_)
+       {
+         const int last = endCols();
+         insertCols(last, 1);
+         for (int i=beginRows(); i<endRows(); ++i) { elt(i, last) = other.elt(i);}
+         return;
+       }
        // compute horizontal range of the container after insertion
        Range cols(this->cols());
 
@@ -634,6 +691,12 @@ class IArray2D: protected IContainer2D<hidden::Traits<Derived>::sizeRows_, hidde
     Allocator allocator_;
     /** range of the index of the columns of the container. **/
     Array1D<Range, sizeCols_> rangeCols_;
+    /** block of memory storing the columns in contiguous mode */
+    Slab slab_;
+    /** leading dimension of slab_ */
+    int ldx_;
+    /** @c true if the columns are stored in slab_ */
+    bool contiguous_;
 
     /** @return the allocator. */
     inline Allocator& allocator() { return allocator_;}
@@ -662,6 +725,32 @@ class IArray2D: protected IContainer2D<hidden::Traits<Derived>::sizeRows_, hidde
     void nullCols(ColRange const& J);
 
   private:
+    /** @return the number of columns that can be stored in slab_ */
+    inline int slabCols() const { return (ldx_ > 0) ? slab_.size()/ldx_ : 0;}
+    /** @return the offset of the column @c col in slab_ such that the element
+     *  (i,col) is stored at slab_.p_data()[slabOffset(col)+i]
+     *  @param col index of the column
+     **/
+    inline int slabOffset(int col) const { return (col-beginCols())*ldx_ - beginRows();}
+    /** @return the leading dimension to use for storing @c n rows */
+    static int alignLdx(int n)
+    { return (n > slabAlign_) ? ((n + slabAlign_ - 1)/slabAlign_)*slabAlign_ : n;}
+    /** @return a reference column vector on the column @c col of slab_
+     *  @param col index of the column
+     **/
+    PtrCol wrapCol(int col) const;
+    /** Reserve slab_ for storing at least @c nbRows rows and @c nbCols
+     *  columns. If the block of memory is reallocated, the leading dimension
+     *  and the number of columns grow geometrically and the existing columns
+     *  are copied and wrapped again.
+     *  @param nbRows,nbCols number of rows and columns to reserve
+     **/
+    void reserveSlab(int nbRows, int nbCols);
+    /** Set the range of the column @c col in contiguous mode, the column is
+     *  wrapped or released if needed.
+     *  @param col,I index and range of the column
+     **/
+    void setSlabCol(int col, Range const& I);
     /** @brief Internal method for memory deallocation.
      *  This method clear all allocated memory and reset ranges to default value.
      *  Do nothing if this is a reference
@@ -776,6 +865,7 @@ template < class  Derived  >
 IArray2D<Derived>::IArray2D(): Base2D(), Base()
                              , allocator_()
                              , rangeCols_()
+                             , slab_(), ldx_(0), contiguous_(contiguousDefault_)
 { mallocCols(this->cols());}
 /** Constructor with specified ranges
  *  @param I,J range of the rows and columns
@@ -785,6 +875,7 @@ IArray2D<Derived>::IArray2D( Range const& I, Range const& J)
                            : Base2D(I,J), Base()
                            , allocator_()
                            , rangeCols_()
+                           , slab_(), ldx_(0), contiguous_(contiguousDefault_)
 {  mallocCols(this->cols()); initializeCols(J);}
 /* Copy constructor
  *  @param T the array to copy
@@ -795,9 +886,12 @@ IArray2D<Derived>::IArray2D( IArray2D const& T, bool ref)
                            : Base2D(T), Base()
                            , allocator_(T.allocator_, ref)
                            , rangeCols_(T.rangeCols_, false) //  have to be created again, in case T is a temporary
+                           , slab_(), ldx_(ref ? T.ldx_ : 0)
+                           , contiguous_(T.contiguous_ && (ref || contiguousStructure_))
 {
   if (!ref)
   {
+    allocator_.setValue(0);   // the pointers on the columns of T are copied
     initializeCols(T.cols()); // initialize the Columns
     for (int j=T.beginCols(); j<T.endCols(); j++)
     { copyCol(T, j);}
@@ -815,6 +909,7 @@ IArray2D<Derived>::IArray2D( IArray2D<OtherDerived> const& T, Range const& I, Ra
                            , rangeCols_(T.rangeCols_, J, false) //  have to be created again, in case T is a temporary
                                           // T.rangeCols_ is itself a temporary that will be deleted
                                           // Tref(T.sub(J), true) for example
+                           , slab_(), ldx_(T.ldx_), contiguous_(T.contiguous_)
 {
   for (int j=J.begin(); j<J.end(); j++)
   { rangeCols_[j] = inf(I, T.rangeCols()[j]);}
@@ -850,6 +945,9 @@ Derived& IArray2D<Derived>::move(Derived const& T)
   // move Base part
   allocator_.move(T.allocator_); // T become a reference
   rangeCols_.move(T.rangeCols_);
+  slab_.move(T.slab_);
+  ldx_ = T.ldx_;
+  contiguous_ = T.contiguous_;
   // Set IContainer2D part
   setCols(T.cols());
   setRows(T.rows());
@@ -865,6 +963,9 @@ void IArray2D<Derived>::exchange(IArray2D &T)
   allocator_.exchange(T.allocator_);
   Base2D::exchange(T);
   rangeCols_.exchange(T.rangeCols_);
+  slab_.exchange(T.slab_);
+  std::swap(ldx_, T.ldx_);
+  std::swap(contiguous_, T.contiguous_);
 }
 
 /* @brief Internal method for memory deallocation.
@@ -881,6 +982,8 @@ void IArray2D< Derived>::freeMem()
   // free memory allocated in allocator.
   // For fixed size arrays, the size remain the same
   allocator_.free();
+  slab_.free();
+  ldx_ = 0;
   setCols(allocator_.range());
   // clear arrays
   rangeCols_.resize(cols());
@@ -930,6 +1033,7 @@ if (beginCols() > J.begin())
 if (endCols() < J.end())
 { STKOUT_OF_RANGE_1ARG(IArray2D::initializeCols, J, endCols() < J.end());}
 #endif
+  if (contiguous_) { reserveSlab(sizeRows(), sizeCols());}
   for (int j=J.begin(); j<J.end(); j++)
   {
     try
@@ -956,6 +1060,12 @@ template< class Derived>
 void IArray2D< Derived>::copyCol(IArray2D const& src, int j)
 {
   PtrCol dp =allocator_.elt(j), sp =src.allocator_.elt(j);
+  // the columns of a contiguous array are references with a fixed range
+  if (contiguous_)
+  {
+    for (int i=rangeCols_[j].begin(); i<rangeCols_[j].end(); ++i) { dp->elt(i) = sp->elt(i);}
+    return;
+  }
   dp->assign(*sp);
 }
 
@@ -976,6 +1086,7 @@ void IArray2D< Derived>::reallocCols(Range const& J)
     Range newRange(J.begin(), size);
     allocator_.realloc( newRange ); // reallocate memory for the columns
   }
+  if (contiguous_) { reserveSlab(sizeRows(), J.size());}
   rangeCols_.resize(J);        // initialize this->rangeCols_
   setCols(J);
 }
@@ -1025,7 +1136,7 @@ void IArray2D< Derived>::initializeCol(int col, Range const& I)
   }
   // try to allocate memory
   try
-  { allocator_.elt(col) = new ColVector(I);}
+  { allocator_.elt(col) = contiguous_ ? wrapCol(col) : new ColVector(I);}
   catch (std::bad_alloc & error)  // if an alloc error occur
   {
     allocator_.elt(col) = 0;
@@ -1053,6 +1164,85 @@ void IArray2D< Derived>::freeCol(int col)
   }
 }
 
+/* Store the columns in a single block of memory or in one allocation per
+ *  column.
+ *  @param contiguous @c true if the columns have to be stored contiguously
+ **/
+template< class Derived>
+void IArray2D< Derived>::setContiguous(bool contiguous)
+{
+  if (contiguous == contiguous_) return;
+  if (isRef())
+  { STKRUNTIME_ERROR_1ARG(IArray2D::setContiguous,contiguous,cannot operate on references);}
+  if (contiguous && !contiguousStructure_)
+  { STKRUNTIME_ERROR_1ARG(IArray2D::setContiguous,contiguous,only general and square arrays can be contiguous);}
+  if (contiguous)
+  { // reserveSlab copy the existing columns in the block of memory
+    contiguous_ = true;
+    reserveSlab(sizeRows(), sizeCols());
+    return;
+  }
+  for (int j=beginCols(); j<endCols(); ++j)
+  {
+    PtrCol p = allocator_.elt(j);
+    if (!p) continue;
+    allocator_.elt(j) = new ColVector(rangeCols_[j]);
+    for (int i=rangeCols_[j].begin(); i<rangeCols_[j].end(); ++i)
+    { allocator_.elt(j)->elt(i) = p->elt(i);}
+    delete p;
+  }
+  slab_.free();
+  ldx_ = 0;
+  contiguous_ = false;
+}
+
+/* @return a reference column vector on the column @c col of slab_
+ *  @param col index of the column
+ **/
+template< class Derived>
+typename IArray2D< Derived>::PtrCol IArray2D< Derived>::wrapCol(int col) const
+{
+  Range I(beginRows(), ldx_);
+  return new ColVector(typename ColVector::Allocator(slab_.p_data() + slabOffset(col), I, true), I, true);
+}
+/* Reserve slab_ for storing at least @c nbRows rows and @c nbCols columns.
+ *  @param nbRows,nbCols number of rows and columns to reserve
+ **/
+template< class Derived>
+void IArray2D< Derived>::reserveSlab(int nbRows, int nbCols)
+{
+  const int capacity = slabCols();
+  if (ldx_ >= nbRows && capacity >= nbCols) return;
+  int ldx  = (ldx_ >= nbRows) ? ldx_ : alignLdx(std::max(nbRows, ldx_ + ldx_/2));
+  int size = (capacity >= nbCols) ? capacity : std::max(nbCols, capacity + capacity/2);
+  if (ldx <= 0) return; // no rows to store
+  Slab slab;
+  slab.malloc(Range(0, ldx*size));
+  // copy the existing columns and wrap them in the new block of memory
+  Range I(beginRows(), ldx);
+  for (int j=beginCols(); j<endCols(); ++j)
+  {
+    PtrCol p = allocator_.elt(j);
+    if (!p) continue;
+    Type* q = slab.p_data() + (j-beginCols())*ldx - beginRows();
+    for (int i=rangeCols_[j].begin(); i<rangeCols_[j].end(); ++i) { q[i] = p->elt(i);}
+    delete p;
+    allocator_.elt(j) = new ColVector(typename ColVector::Allocator(q, I, true), I, true);
+  }
+  slab_.exchange(slab);
+  ldx_ = ldx;
+}
+/* Set the range of the column @c col in contiguous mode.
+ *  @param col,I index and range of the column
+ **/
+template< class Derived>
+void IArray2D< Derived>::setSlabCol(int col, Range const& I)
+{
+  if (I.size() <= 0) { freeCol(col);}
+  else if (!allocator_.elt(col)) { allocator_.elt(col) = wrapCol(col);}
+  rangeCols_[col] = I;
+}
+
 } // namespace STK
 
 #endif
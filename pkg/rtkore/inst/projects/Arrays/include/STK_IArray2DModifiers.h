@@ -53,23 +53,37 @@ void IArray2D< Derived>::reserve(int sizeRows, int sizeCols)
  **/
 template < class  Derived  >
 void IArray2D< Derived>::reserveRows(int size)
-{ reserveRowsCols(cols(), size);}
+{
+  if (contiguous_)
+  {
+    if (ldx_ >= size) return;
+    if (isRef())
+    { STKRUNTIME_ERROR_1ARG(IArray2D::reserveRows,size,cannot operate on references);}
+    reserveSlab(size, sizeCols());
+    return;
+  }
+  reserveRowsCols(cols(), size);
+}
 /*Reserve a certain amount of columns
  *  @param sizeCols the size to reserve.
  **/
 template< class Derived>
 void IArray2D< Derived>::reserveCols(int sizeCols)
 {
-  if (availableCols() >= sizeCols) return;
+  if (availableCols() >= sizeCols && (!contiguous_ || slabCols() >= sizeCols)) return;
   // is this structure just a pointer?
   if (isRef())
   { STKRUNTIME_ERROR_1ARG(IArray2D::reserveCols,sizeCols,cannot operate on references);}
   // try to allocate memory
   try
   {
-    Range J(this->beginCols(), sizeCols);
-    allocator_.realloc(J);
-    rangeCols_.reserve(J.size());
+    if (availableCols() < sizeCols)
+    {
+      Range J(this->beginCols(), sizeCols);
+      allocator_.realloc(J);
+      rangeCols_.reserve(J.size());
+    }
+    if (contiguous_) { reserveSlab(sizeRows(), sizeCols);}
   }
   catch (Exception const& error)   // if an error occur
   {
@@ -94,7 +108,7 @@ void IArray2D< Derived>::reserveRowsCols(Range const& J, int size)
 template < class  Derived  >
 void IArray2D< Derived>::reserveRowCol( int col, int size)
 {
-  if (this->capacityCol(col) >= size) return;
+  if (!allocator_.elt(col) || this->capacityCol(col) >= size) return;
   allocator_.elt(col)->reserve(size);
 }
 
@@ -132,6 +146,16 @@ void IArray2D< Derived>::shiftRows( int beg)
   // if there is rows, for all cols shift
   for (int j=beginCols(); j<endCols(); j++)
   { shiftRowCol(j, rangeCols_[j].begin()+inc);}
+  // the columns of a contiguous array have to be wrapped again
+  if (contiguous_)
+  {
+    for (int j=beginCols(); j<endCols(); j++)
+    {
+      if (!allocator_.elt(j)) continue;
+      delete allocator_.elt(j);
+      allocator_.elt(j) = wrapCol(j);
+    }
+  }
 }
 /*New beginning index for the columns of the object.
  *  @param cbeg the index of the first column to set
@@ -158,7 +182,7 @@ void IArray2D< Derived>::shiftCols(int cbeg)
 template < class  Derived  >
 void IArray2D< Derived>::shiftRowCol( int col, int beg)
 {
-  if (allocator_.elt(col)) { allocator_.elt(col)->shift(beg);}
+  if (allocator_.elt(col) && !contiguous_) { allocator_.elt(col)->shift(beg);}
   rangeCols_[col].shift(beg);
 }
 /*resize the array.
@@ -398,9 +422,13 @@ Derived& IArray2D< Derived>::pushFrontCols(ExprBase<Other> const& other)
   { STKRUNTIME_ERROR_NO_ARG(IArray2D::pushFrontCols,range of the rows are different);}
   // if the array is not empty we add the column and copy other inside
   this->asDerived().insertCols(beginCols(), other.sizeCols());
-  for (int j= beginCols(), j1= other.beginCols(); j < endCols(); ++j, ++j1)
+  for (int j= beginCols(), j1= other.beginCols(); j1 < other.endCols(); ++j, ++j1)
   {
-    *allocator_.elt(j) = other.col(j1);
+    if (contiguous_)
+    {
+      for (int i=beginRows(); i<endRows(); ++i) { elt(i, j) = other.elt(i, j1);}
+    }
+    else { *allocator_.elt(j) = other.col(j1);}
   }
   // return this
   return this->asDerived();
@@ -453,6 +481,15 @@ template < class  Derived  >
    Range OldRange(cols()), NewRange(cols());
    NewRange.incLast(n);
    reallocCols(NewRange);
+   if (contiguous_)
+   {
+     // the wrappers stay in place, the data of the last columns are moved
+     for (int j=OldRange.end(); j<NewRange.end(); ++j) { allocator_.elt(j) = 0;}
+     slab_.memmove(slabOffset(pos+n) + beginRows(), Range(slabOffset(pos) + beginRows(), (OldRange.end()-pos)*ldx_));
+     for (int k=OldRange.lastIdx(); k>=pos; k--) { setSlabCol(k+n, rangeCols_[k]);}
+     for (int j=pos; j<pos+n; ++j) { setSlabCol(j, this->rangeRowsInCol(j));}
+     return;
+   }
    // translate and copy last Columns from Taux to this
    for (int k=OldRange.lastIdx(); k>=pos; k--)
    { transferCol(k+n, k);}
@@ -478,6 +515,17 @@ template < class  Derived  >
    if (endCols() < pos+n)
    { STKOUT_OF_RANGE_2ARG(IArray2D::eraseCols,pos,n,endCols() < pos+n);}
 #endif
+   if (contiguous_)
+   {
+     // the wrappers stay in place, the data of the last columns are moved
+     slab_.memmove(slabOffset(pos) + beginRows(), Range(slabOffset(pos+n) + beginRows(), (endCols()-pos-n)*ldx_));
+     for (int j=pos; j<endCols()-n; ++j) { setSlabCol(j, rangeCols_[j+n]);}
+     freeCols(Range(endCols()-n, n));
+     rangeCols_.erase(endCols()-n, n);
+     this->decLastIdxCols(n);
+     if (sizeCols() == 0) { freeMem();}
+     return;
+   }
    // delete each col
    freeCols(Range(pos, n));
    // update cols_, rangeCols_
@@ -508,6 +556,7 @@ template < class  Derived  >
    { STKOUT_OF_RANGE_2ARG(IArray2D::insertRows,pos,n,endRows() < pos);}
 #endif
 
+   if (contiguous_) { reserveSlab(sizeRows()+n, sizeCols());}
    this->incLastIdxRows(n);
    for (int j=beginCols(); j<endCols(); j++)
    {
@@ -601,6 +650,12 @@ template < class  Derived  >
 void IArray2D< Derived>::resizeRowCol( int col, Range const& I)
 {
   if (rangeCols_[col] == I) return;
+  if (contiguous_)
+  {
+    if (I.size() > 0) { reserveSlab(I.end()-beginRows(), sizeCols());}
+    setSlabCol(col, I);
+    return;
+  }
   shiftRowCol(col, I.begin());
   int inc = rangeCols_[col].size() - I.size();
   if (inc == 0) return;
@@ -624,7 +679,12 @@ void IArray2D< Derived>::resizeRowCol( int col, Range const& I)
 template < class  Derived  >
 void IArray2D< Derived>::insertRowsCol( int col, int pos, int n)
 {
-  allocator_.elt(col)->insertElt(pos, n);
+  if (contiguous_)
+  {
+    const int offset = slabOffset(col);
+    slab_.memmove(offset+pos+n, Range(offset+pos, rangeCols_[col].end()-pos));
+  }
+  else { allocator_.elt(col)->insertElt(pos, n);}
   rangeCols_[col].incLast(n);
 }
 /*@brief Internal method for deleting rows from a specified column.
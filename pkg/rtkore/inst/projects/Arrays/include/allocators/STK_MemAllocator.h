@@ -44,6 +44,7 @@
 #include <Sdk/include/STK_Exceptions.h>
 #include <STKernel/include/STK_Range.h>
 #include <Sdk/include/STK_Macros.h>
+#include "STK_MemPool.h"
 
 namespace STK
 {
@@ -51,6 +52,74 @@ namespace STK
 namespace hidden
 {
 
+/** @ingroup hidden Helper class allowing to use std::memcpy or std::memmove for
+ *  fundamental types
+ **/
+template<int, class Type_> struct MemChooser;
+
+/** @ingroup hidden
+ *  Specialization for fundamental types.
+ *  copy or move memory using standard C copy and move functions
+ * */
+template<class Type_> struct MemChooser<1, Type_>
+{
+  static Type_* memcpy(Type_* p, Type_* q, size_t size)
+  { return static_cast<Type_*>(std::memcpy( p , q, sizeof(Type_)*size));}
+
+  static Type_* memmove(Type_* p, Type_* q, size_t size)
+  { return static_cast<Type_*>(std::memmove( p, q, sizeof(Type_)*size));}
+};
+
+/** @ingroup hidden
+ *  Specialization for other types using loop and operator= */
+template<class Type_> struct MemChooser<0, Type_>
+{
+  static Type_* memcpy(Type_* p, Type_* q, size_t size)
+  {
+    for (size_t k=0; k<size; k++) { p[k] = q[k];}
+    return p;
+  }
+  static Type_* memmove(Type_* p, Type_* q, size_t size)
+  {
+    if (size == 0) return p;
+    if (p<q) { for (size_t k=0; k<size; k++)    { p[k] = q[k];}}
+    else     { for (size_t k=size; k-- > 0;)    { p[k] = q[k];}}
+    return p;
+  }
+};
+
+/** @ingroup hidden
+ *  Helper class allocating the blocks of memory of the arrays. The blocks of
+ *  the arithmetic types are taken in the aligned MemPool, the other types
+ *  use new and delete.
+ **/
+template<bool isPooled_, typename Type_> struct MemBlock;
+
+/** @ingroup hidden
+ *  Specialization for the arithmetic types. */
+template<typename Type_> struct MemBlock<true, Type_>
+{
+  /** @return a block of n elements, aligned on MemPool::alignment_ bytes */
+  static Type_* allocate(int n)
+  { return static_cast<Type_*>(MemPool::allocate(sizeof(Type_)*n));}
+  /** release the block p of n elements */
+  static void release(Type_* p, int n) { MemPool::release(p, sizeof(Type_)*n);}
+  /** @return @c true if a block of n elements can store m elements */
+  static bool isReusable(int n, int m)
+  { return MemPool::sizeClass(sizeof(Type_)*n) == MemPool::sizeClass(sizeof(Type_)*m)
+        && MemPool::sizeClass(sizeof(Type_)*m) < MemPool::nbClasses_;
+  }
+};
+
+/** @ingroup hidden
+ *  Specialization for the other types. */
+template<typename Type_> struct MemBlock<false, Type_>
+{
+  static Type_* allocate(int n) { return new Type_[n];}
+  static void release(Type_* p, int) { delete [] p;}
+  static bool isReusable(int, int) { return false;}
+};
+
 /** @ingroup hidden
  *  Helper class allowing to free memory (or not)
  *  @note for fixed size containers, free do nothing, realloc adjust the shift
@@ -66,13 +135,7 @@ template<typename Type_, int Size_> struct MemHandler
   static Type_* malloc(Type_* p_data, AllocatorRange const& range)
   {
     if (!p_data)
-    {
-      if(range.size()>0)
-      {
-        p_data = new Type_[range.size()];
-        p_data -= range.begin();
-      }
-    }
+    { p_data = MemHandler<Type_, UnknownSize>::malloc(p_data, range);}
     return p_data;
   }
   /** realloc main pointer and copy existing data. */
@@ -89,6 +152,8 @@ template<typename Type_, int Size_> struct MemHandler
  * */
 template<class Type_> struct MemHandler<Type_, UnknownSize>
 {
+  enum { isPooled_ = IsArithmetic<Type_>::yes};
+  typedef MemBlock<isPooled_, Type_> Block;
   typedef TRange<UnknownSize> AllocatorRange;
   /** shift data pointer and delete allocated memory */
   static Type_* free(Type_* p_data, AllocatorRange const& range)
@@ -97,7 +162,7 @@ template<class Type_> struct MemHandler<Type_, UnknownSize>
     if (p_data)
     {
       p_data+=range.begin();
-      delete [] p_data; // erase
+      Block::release(p_data, range.size()); // erase
       p_data = 0;
     }
     return p_data;
@@ -107,58 +172,30 @@ template<class Type_> struct MemHandler<Type_, UnknownSize>
   {
     if(range.size()>0)
     {
-      p_data = new Type_[range.size()];
+      p_data = Block::allocate(range.size());
       p_data -= range.begin();
     }
     else
     { p_data = 0;}
     return p_data;
   }
-  /** realloc main pointer and copy existing data. */
+  /** realloc main pointer and copy existing data. If the block is large
+   *  enough it is reused and the data are moved inside it. */
   template<int OtherSize>
   static Type_* realloc( Type_* p_data, AllocatorRange const& range, TRange<OtherSize> const& I)
   {
-    Type_* p = 0;
-    p = malloc(p, I);
     Range r = inf(range, I);
-    for (int i = r.begin(); i<r.end(); ++i) { p[i] = p_data[i];}
-    p_data = free(p_data, range);
-    return p;
-  }
-};
-
-/** @ingroup hidden Helper class allowing to use std::memcpy or std::memmove for
- *  fundamental types
- **/
-template<int, class Type_> struct MemChooser;
-
-/** @ingroup hidden
- *  Specialization for fundamental types.
- *  copy or move memory using standard C copy and move functions
- * */
-template<class Type_> struct MemChooser<1, Type_>
-{
-  static Type_* memcpy(Type_* p, Type_* q, size_t size)
-  { return static_cast<Type_*>(std::memcpy( p , q, sizeof(Type_)*size));}
-
-  static Type_* memmove(Type_* p, Type_* q, size_t size)
-  { return static_cast<Type_*>(std::memmove( p, q, sizeof(Type_)*size));}
-};
-
-/** @ingroup hidden
- *  Specialization for other types using loop and operator= */
-template<class Type_> struct MemChooser<0, Type_>
-{
-  static Type_* memcpy(Type_* p, Type_* q, size_t size)
-  {
-    for (size_t k=0; k<size; k++) { p[k] = q[k];}
-    return p;
-  }
-  static Type_* memmove(Type_* p, Type_* q, size_t size)
-  {
-    if (size == 0) return p;
-    if (p<q) { for (size_t k=0; k<size; k++)    { p[k] = q[k];}}
-    else     { for (size_t k=size-1; k==0; --k) { p[k] = q[k];}}
+    if (p_data && Block::isReusable(range.size(), I.size()))
+    {
+      Type_* p = p_data + range.begin() - I.begin();
+      if (r.size()>0 && p != p_data)
+      { MemChooser<isPooled_, Type_>::memmove(p+r.begin(), p_data+r.begin(), r.size());}
+      return p;
+    }
+    Type_* p = malloc(0, I);
+    if (p_data && r.size()>0)
+    { MemChooser<isPooled_, Type_>::memcpy(p+r.begin(), p_data+r.begin(), r.size());}
+    free(p_data, range);
     return p;
   }
 };
@@ -633,15 +670,18 @@ void MemAllocator<Type,Size_>::realloc( TRange<OtherSize> const& I)
 
   try
   {
-    // allocate memory and copy data in the same range
-    Type* p  = MemHandler::malloc(p_data_, I);
-    // copy data in common range
-    Range r = inf(range_, I);
-    if (r.size()>0)
-    { MemChooser::memcpy(p+r.begin(), p_data_+r.begin(), r.size());      }
-//    for (int i = r.begin(); i<r.end(); ++i) { p[i] = p_data_[i];}
-    p_data_ = MemHandler::free(p_data_, range_);
-    setPtr(p, I, false);
+    // a reference is copied in a new block
+    if (isRef())
+    {
+      Type* p  = hidden::MemHandler<Type, UnknownSize>::malloc(0, I);
+      Range r = inf(range_, I);
+      if (r.size()>0)
+      { MemChooser::memcpy(p+r.begin(), p_data_+r.begin(), r.size());}
+      setPtr(p, I, false);
+      return;
+    }
+    // allocate memory (or reuse the block) and copy data in the common range
+    setPtr(MemHandler::realloc(p_data_, range_, I), I, false);
   }
   catch (std::bad_alloc const& error)
   { STKRUNTIME_ERROR_1ARG(MemAllocator::realloc, I, memory allocation failed);}
@@ -0,0 +1,208 @@
+/*--------------------------------------------------------------------*/
+/*     Copyright (C) 2004-2016  Serge Iovleff, Université Lille 1, Inria
+
+    This program is free software; you can redistribute it and/or modify
+    it under the terms of the GNU Lesser General Public License as
+    published by the Free Software Foundation; either version 2 of the
+    License, or (at your option) any later version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU Lesser General Public License for more details.
+
+    You should have received a copy of the GNU Lesser General Public
+    License along with this program; if not, write to the
+    Free Software Foundation, Inc.,
+    59 Temple Place,
+    Suite 330,
+    Boston, MA 02111-1307
+    USA
+
+    Contact : S..._Dot_I..._At_stkpp_Dot_org (see copyright for ...)
+*/
+
+/*
+ * Project:  stkpp::Arrays
+ * Purpose:  Pool of aligned blocks of memory used by the allocators.
+ * Author:   Serge Iovleff, S..._Dot_I..._At_stkpp_Dot_org (see copyright for ...)
+ *
+ **/
+
+/** @file STK_MemPool.h
+ *  @brief In this file we define the pool of aligned blocks of memory used
+ *  by the MemAllocator class for the arithmetic types.
+ **/
+
+#ifndef STK_MEMPOOL_H
+#define STK_MEMPOOL_H
+
+#include <cstdlib>
+#include <new>
+#include <vector>
+#include <atomic>
+
+namespace STK
+{
+
+namespace hidden
+{
+
+/** @ingroup hidden
+ *  @brief Pool of aligned blocks of memory.
+ *
+ *  The blocks are aligned on alignment_ bytes and their sizes are rounded
+ *  to a power of two times alignment_. Each thread keeps the released
+ *  blocks of each size class in a cache, up to maxCachedBytes_ bytes, and
+ *  reuse them for the next allocations of the same class. A block released
+ *  by an other thread than the one which allocated it goes in the cache of
+ *  the releasing thread, so the total size of the caches is also bounded by
+ *  maxTotalCachedBytes_. Blocks larger than the last size class are
+ *  allocated and released directly.
+ *
+ *  The cache of a thread is destroyed at the exit of the thread. The blocks
+ *  allocated or released after (by the destructors of other thread local
+ *  or static objects) are not cached.
+ *
+ *  If STK_NO_MEMPOOL is defined the blocks are not cached (useful with
+ *  memory checkers).
+ **/
+struct MemPool
+{
+  enum
+  {
+    /** alignment of the blocks in bytes */
+    alignment_ = 64,
+    /** number of size classes: from 64 bytes to 2 Mb */
+    nbClasses_ = 16,
+    /** maximal number of bytes cached by each thread */
+    maxCachedBytes_ = 16*1024*1024,
+    /** maximal number of bytes cached by all the threads */
+    maxTotalCachedBytes_ = 64*1024*1024
+  };
+  /** @return the size class of a block of @c bytes bytes, nbClasses_ if the
+   *  block is too large to be cached
+   **/
+  static int sizeClass(size_t bytes)
+  {
+    int c = 0;
+    size_t size = alignment_;
+    while (size < bytes && c < nbClasses_) { size <<= 1; ++c;}
+    return c;
+  }
+  /** @return the number of bytes of the blocks of the class @c c */
+  static size_t classBytes(int c) { return size_t(alignment_) << c;}
+  /** @return the number of bytes really usable in a block of @c bytes bytes */
+  static size_t capacity(size_t bytes)
+  {
+    int c = sizeClass(bytes);
+    return (c < nbClasses_) ? classBytes(c) : bytes;
+  }
+  /** @return an aligned block of at least @c bytes bytes
+   *  @throw std::bad_alloc if the allocation fails
+   **/
+  static void* allocate(size_t bytes)
+  {
+    int c = sizeClass(bytes);
+    if (c < nbClasses_)
+    {
+#ifndef STK_NO_MEMPOOL
+      Cache* p_cache = threadCache();
+      if (p_cache && !p_cache->blocks_[c].empty())
+      {
+        void* p = p_cache->blocks_[c].back();
+        p_cache->blocks_[c].pop_back();
+        p_cache->bytes_ -= classBytes(c);
+        totalBytes() -= classBytes(c);
+        return p;
+      }
+#endif
+      bytes = classBytes(c);
+    }
+    return alignedMalloc(bytes);
+  }
+  /** release a block allocated by allocate.
+   *  @param p,bytes the block and its size (as given to allocate)
+   **/
+  static void release(void* p, size_t bytes)
+  {
+    if (!p) return;
+#ifndef STK_NO_MEMPOOL
+    int c = sizeClass(bytes);
+    Cache* p_cache = (c < nbClasses_) ? threadCache() : 0;
+    if (p_cache && p_cache->bytes_ + classBytes(c) <= size_t(maxCachedBytes_))
+    {
+      // reserve the bytes in the total before caching the block
+      if (totalBytes().fetch_add(classBytes(c)) + classBytes(c) <= size_t(maxTotalCachedBytes_))
+      {
+        p_cache->blocks_[c].push_back(p);
+        p_cache->bytes_ += classBytes(c);
+        return;
+      }
+      totalBytes() -= classBytes(c);
+    }
+#endif
+    alignedFree(p);
+  }
+
+  private:
+    /** cache of the released blocks of a thread */
+    struct Cache
+    {
+      Cache(): bytes_(0) { state() = alive_;}
+      ~Cache()
+      {
+        state() = destroyed_;
+        for (int c=0; c<nbClasses_; ++c)
+        {
+          for (size_t k=0; k<blocks_[c].size(); ++k) { alignedFree(blocks_[c][k]);}
+        }
+        totalBytes() -= bytes_;
+      }
+      /** released blocks of each size class */
+      std::vector<void*> blocks_[nbClasses_];
+      /** number of bytes in the cache */
+      size_t bytes_;
+    };
+    /** state of the cache of a thread */
+    enum CacheState { notCreated_ = 0, alive_, destroyed_};
+    /** @return the state of the cache of the current thread. This variable
+     *  has no destructor, so it can be read after the exit of the thread
+     **/
+    static int& state()
+    {
+      static thread_local int state = notCreated_;
+      return state;
+    }
+    /** @return the number of bytes cached by all the threads */
+    static std::atomic<size_t>& totalBytes()
+    {
+      static std::atomic<size_t> bytes(0);
+      return bytes;
+    }
+    /** @return the cache of the current thread, 0 if it is destroyed */
+    static Cache* threadCache()
+    {
+      if (state() == destroyed_) return 0;
+      static thread_local Cache cache;
+      return &cache;
+    }
+    /** @return an aligned block of @c bytes bytes. The address returned by
+     *  malloc is stored just before the block. */
+    static void* alignedMalloc(size_t bytes)
+    {
+      void* raw = std::malloc(bytes + alignment_);
+      if (!raw) throw std::bad_alloc();
+      void* p = reinterpret_cast<void*>((reinterpret_cast<size_t>(raw) + alignment_) & ~size_t(alignment_-1));
+      (static_cast<void**>(p))[-1] = raw;
+      return p;
+    }
+    /** free a block allocated by alignedMalloc */
+    static void alignedFree(void* p) { std::free((static_cast<void**>(p))[-1]);}
+};
+
+} // namespace hidden
+
+} // namespace STK
+
+#endif /* STK_MEMPOOL_H */
@@ -29,7 +29,8 @@
  **/
 
 /** @file STK_SlicingOperators.h
- *  @brief In this file we implement the RowOperator, ColOperator, SubVectorOperator and SubOperator classes.
+ *  @brief In this file we implement the RowOperator, ColOperator, SubVectorOperator,
+ *  SubOperator and RowSelectOperator classes.
  **/
 
 #ifndef STK_SLICINGOPERATORS_H
@@ -44,6 +45,8 @@ template< typename Array> class ColOperator;
 template< typename Array, int Size_> class SubVectorOperator;
 // only for array expressions
 template< typename Array, int SizeRows_, int SizeCols_> class SubOperator;
+// selection of rows by indexes
+template< typename Array, typename Indexes> class RowSelectOperator;
 
 namespace hidden
 {
@@ -512,6 +515,109 @@ class SubOperator: public ExprBase< SubOperator<Lhs, SizeRows_, SizeCols_> >
     ColRange cols_;
 };
 
+namespace hidden
+{
+/** @ingroup hidden
+ *  @brief Traits class for the row selection operator
+ */
+template<typename Lhs, typename Indexes>
+struct Traits< RowSelectOperator <Lhs, Indexes> >
+{
+  enum
+  {
+    structure_ = (Lhs::structure_ == int(Arrays::vector_)) ? Arrays::vector_ : Arrays::array2D_,
+    orient_    = Lhs::orient_,
+    sizeRows_  = UnknownSize,
+    sizeCols_  = Lhs::sizeCols_,
+    storage_   = Arrays::dense_
+  };
+  typedef typename Lhs::Type Type;
+  typedef typename Lhs::TypeConst TypeConst;
+};
+
+} // namespace hidden
+
+/** @ingroup Arrays
+  * @class RowSelectOperator
+  *
+  * @brief Generic expression when a selection of the rows of an expression
+  * is accessed
+  *
+  * @tparam Lhs the type of the array or expression to which we are
+  * applying the row selection.
+  * @tparam Indexes the type of the vector of indexes of the selected rows
+  *
+  * The row @c i of this expression is the row @c idx[i] of the expression
+  * @c lhs. The data are not copied, thus a selection of rows (for example the
+  * learning set of a fold in a cross validation) can be used in any
+  * expression. It is the return type of the @c selectRows(idx) operation.
+  *
+  * @warning As the other operators, this class stores references on @c lhs
+  * and on the vector of indexes @c idx: they have to outlive the expression.
+  * A temporary vector of indexes can be used in a full expression, but not
+  * if the expression is stored, e.g.
+  * @code
+  *   Real res = x.selectRows(CVectorXi(test)).sum(); // ok
+  *   RowSelectOperator<CArrayXX, CVectorXi> const rows = x.selectRows(CVectorXi(test));
+  *   res = rows.sum(); // dangling reference on the indexes
+  * @endcode
+  */
+template< typename Lhs, typename Indexes>
+class RowSelectOperator: public ExprBase< RowSelectOperator<Lhs, Indexes> >
+                       , public TRef<1>
+{
+  public:
+    typedef typename hidden::Traits< RowSelectOperator<Lhs, Indexes> >::Type Type;
+    typedef typename hidden::Traits< RowSelectOperator<Lhs, Indexes> >::TypeConst TypeConst;
+    enum
+    {
+      structure_ = hidden::Traits< RowSelectOperator<Lhs, Indexes> >::structure_,
+      orient_    = hidden::Traits< RowSelectOperator<Lhs, Indexes> >::orient_,
+      sizeRows_  = hidden::Traits< RowSelectOperator<Lhs, Indexes> >::sizeRows_,
+      sizeCols_  = hidden::Traits< RowSelectOperator<Lhs, Indexes> >::sizeCols_,
+      storage_   = hidden::Traits< RowSelectOperator<Lhs, Indexes> >::storage_
+    };
+    typedef ExprBase< RowSelectOperator<Lhs, Indexes> > Base;
+
+    /** Type of the Range for the rows */
+    typedef TRange<sizeRows_> RowRange;
+    /** Type of the Range for the columns */
+    typedef TRange<sizeCols_> ColRange;
+
+    /** constructor
+     *  @param lhs the expression
+     *  @param idx the indexes of the selected rows of lhs
+     **/
+    inline RowSelectOperator( Lhs const& lhs, Indexes const& idx)
+                            : Base(), lhs_(lhs), idx_(idx)
+                            , rows_(idx.begin(), idx.size()), cols_(lhs.cols())
+    {}
+    /**  @return the range of the rows */
+    inline RowRange const& rowsImpl() const { return rows_;}
+    /** @return the range of the Columns */
+    inline ColRange const& colsImpl() const { return cols_;}
+    /** @return the left hand side expression */
+    inline Lhs const& lhs() const { return lhs_;}
+    /** @return the indexes of the selected rows */
+    inline Indexes const& idx() const { return idx_;}
+
+    /** @return element (i,j)
+     *  @param i,j row and column indexes
+     **/
+    inline TypeConst elt2Impl(int i, int j) const { return (lhs_.elt(idx_.elt(i), j));}
+    /** @return i-th element
+     *  @param i element index
+     **/
+    inline TypeConst elt1Impl(int i) const { return (lhs_.elt(idx_.elt(i)));}
+    /** accesses to the element */
+    inline TypeConst elt0Impl() const { return (lhs_.elt());}
+
+  protected:
+    Lhs const& lhs_;
+    Indexes const& idx_;
+    RowRange rows_;
+    ColRange cols_;
+};
 
 } // namespace STK
 
@@ -0,0 +1,245 @@
+/*--------------------------------------------------------------------*/
+/*     Copyright (C) 2004-2016  Serge Iovleff, Université Lille 1, Inria
+
+    This program is free software; you can redistribute it and/or modify
+    it under the terms of the GNU Lesser General Public License as
+    published by the Free Software Foundation; either version 2 of the
+    License, or (at your option) any later version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU Lesser General Public License for more details.
+
+    You should have received a copy of the GNU Lesser General Public
+    License along with this program; if not, write to the
+    Free Software Foundation, Inc.,
+    59 Temple Place,
+    Suite 330,
+    Boston, MA 02111-1307
+    USA
+
+    Contact : S..._Dot_I..._At_stkpp_Dot_org (see copyright for ...)
+*/
+
+/*
+ * Project:  stkpp::Arrays
+ * Purpose:  Use the BLAS for the products of contiguous arrays.
+ * Author:   iovleff, S..._Dot_I..._At_stkpp_Dot_org (see copyright for ...)
+ **/
+
+/** @file STK_ProductBlas.h
+ *  @brief In this file we implement the product of two contiguous arrays
+ *  using the BLAS routine gemm when STKUSELAPACK is defined. The CArray and
+ *  the Array2D stored in a single block of memory can be used.
+ **/
+
+#ifndef STK_PRODUCTBLAS_H
+#define STK_PRODUCTBLAS_H
+
+#ifdef STKUSELAPACK
+
+extern "C"
+{
+#ifdef STKREALAREFLOAT
+/** BLAS routine in float computing a general matrix product */
+extern void sgemm_( char *transa, char *transb, int *m, int *n, int *k
+                  , float *alpha, float *a, int *lda, float *b, int *ldb
+                  , float *beta, float *c, int *ldc);
+#else
+/** BLAS routine in double computing a general matrix product */
+extern void dgemm_( char *transa, char *transb, int *m, int *n, int *k
+                  , double *alpha, double *a, int *lda, double *b, int *ldb
+                  , double *beta, double *c, int *ldc);
+#endif
+} // extern "C"
+
+#endif // STKUSELAPACK
+
+namespace STK
+{
+// forward declarations
+template< typename Type, int SizeRows_, int SizeCols_, bool Orient_> class CArray;
+template< typename Type, int Size_, bool Orient_> class CArraySquare;
+template< typename Type> class Array2D;
+template< typename Type> class Array2DSquare;
+template< typename Lhs> class TransposeOperator;
+template< typename Lhs> class TransposeAccessor;
+
+/** minimal number of multiplications (rows*cols*inner size) of a product
+ *  computed by the BLAS. Smaller products use the native kernels. */
+const int blasMinSize_ = 32768;
+
+namespace hidden
+{
+/** @ingroup hidden
+ *  Give access to the contiguous storage of an operand of a product. By
+ *  default an expression cannot be used by the BLAS.
+ **/
+template<class Array>
+struct BlasOperand
+{ enum { isBlas_ = false, orient_ = Arrays::by_col_}; };
+
+/** specialization for the CArray */
+template<typename Type, int SizeRows_, int SizeCols_, bool Orient_>
+struct BlasOperand< CArray<Type, SizeRows_, SizeCols_, Orient_> >
+{
+  typedef CArray<Type, SizeRows_, SizeCols_, Orient_> Array;
+  enum { isBlas_ = isSame<typename RemoveConst<Type>::Type, Real>::value_, orient_ = Orient_};
+  /** @return a pointer on the first element of a */
+  static Type const* p_data(Array const& a)
+  {
+    return Orient_ ? a.p_data() + a.beginCols()*a.allocator().ldx() + a.beginRows()
+                   : a.p_data() + a.beginRows()*a.allocator().ldx() + a.beginCols();
+  }
+  /** @return the leading dimension of a */
+  static int ldx(Array const& a) { return a.allocator().ldx();}
+  /** @return @c true, the CArray are always contiguous */
+  static bool isContiguous(Array const& /*a*/) { return true;}
+};
+
+/** specialization for the CArraySquare */
+template<typename Type, int Size_, bool Orient_>
+struct BlasOperand< CArraySquare<Type, Size_, Orient_> >
+{
+  typedef CArraySquare<Type, Size_, Orient_> Array;
+  enum { isBlas_ = isSame<typename RemoveConst<Type>::Type, Real>::value_, orient_ = Orient_};
+  /** @return a pointer on the first element of a */
+  static Type const* p_data(Array const& a)
+  {
+    return Orient_ ? a.p_data() + a.beginCols()*a.allocator().ldx() + a.beginRows()
+                   : a.p_data() + a.beginRows()*a.allocator().ldx() + a.beginCols();
+  }
+  /** @return the leading dimension of a */
+  static int ldx(Array const& a) { return a.allocator().ldx();}
+  /** @return @c true, the CArray are always contiguous */
+  static bool isContiguous(Array const& /*a*/) { return true;}
+};
+
+/** specialization for the Array2D: only the arrays stored in a single block
+ *  of memory can be used by the BLAS */
+template<typename Type>
+struct BlasOperand< Array2D<Type> >
+{
+  typedef Array2D<Type> Array;
+  enum { isBlas_ = isSame<typename RemoveConst<Type>::Type, Real>::value_, orient_ = Arrays::by_col_};
+  /** @return a pointer on the first element of a */
+  static Type const* p_data(Array const& a) { return &a.elt(a.beginRows(), a.beginCols());}
+  /** @return the leading dimension of a */
+  static int ldx(Array const& a) { return a.ldx();}
+  /** @return @c true if a is stored in a single block of memory */
+  static bool isContiguous(Array const& a) { return a.isContiguous() && a.ldx() > 0;}
+};
+
+/** specialization for the Array2DSquare */
+template<typename Type>
+struct BlasOperand< Array2DSquare<Type> >
+{
+  typedef Array2DSquare<Type> Array;
+  enum { isBlas_ = isSame<typename RemoveConst<Type>::Type, Real>::value_, orient_ = Arrays::by_col_};
+  /** @return a pointer on the first element of a */
+  static Type const* p_data(Array const& a) { return &a.elt(a.beginRows(), a.beginCols());}
+  /** @return the leading dimension of a */
+  static int ldx(Array const& a) { return a.ldx();}
+  /** @return @c true if a is stored in a single block of memory */
+  static bool isContiguous(Array const& a) { return a.isContiguous() && a.ldx() > 0;}
+};
+
+/** specialization for the transposed arrays: the storage is the storage
+ *  of the array with the opposite orientation */
+template<class Lhs>
+struct BlasOperand< TransposeOperator<Lhs> >
+{
+  typedef BlasOperand<typename RemoveConst<Lhs>::Type> Base;
+  enum { isBlas_ = Base::isBlas_, orient_ = !Base::orient_};
+  static Real const* p_data(TransposeOperator<Lhs> const& a) { return Base::p_data(a.lhs());}
+  static int ldx(TransposeOperator<Lhs> const& a) { return Base::ldx(a.lhs());}
+  static bool isContiguous(TransposeOperator<Lhs> const& a) { return Base::isContiguous(a.lhs());}
+};
+
+/** specialization for the transposed arrays */
+template<class Lhs>
+struct BlasOperand< TransposeAccessor<Lhs> >
+{
+  typedef BlasOperand<typename RemoveConst<Lhs>::Type> Base;
+  enum { isBlas_ = Base::isBlas_, orient_ = !Base::orient_};
+  static Real const* p_data(TransposeAccessor<Lhs> const& a) { return Base::p_data(a.lhs());}
+  static int ldx(TransposeAccessor<Lhs> const& a) { return Base::ldx(a.lhs());}
+  static bool isContiguous(TransposeAccessor<Lhs> const& a) { return Base::isContiguous(a.lhs());}
+};
+
+/** @ingroup hidden
+ *  Compute the product of two arrays using the BLAS. The default
+ *  implementation is used when STKUSELAPACK is not defined or when the
+ *  operands are not contiguous arrays of Real: nothing is done.
+ **/
+template<class Lhs, class Rhs, class Result, bool isBlas_ =
+#ifdef STKUSELAPACK
+    BlasOperand<Lhs>::isBlas_ && BlasOperand<Rhs>::isBlas_
+    && isSame<typename Result::Type, Real>::value_
+#else
+    false
+#endif
+    >
+struct BlasProduct
+{
+  /** @return @c false, the product has to be computed by the native kernels */
+  static bool run(Lhs const& /*lhs*/, Rhs const& /*rhs*/, Result& /*res*/) { return false;}
+};
+
+#ifdef STKUSELAPACK
+/** specialization for the contiguous arrays of Real */
+template<class Lhs, class Rhs, class Result>
+struct BlasProduct<Lhs, Rhs, Result, true>
+{
+  /** compute res = lhs * rhs using the gemm routine if the product is large
+   *  enough.
+   *  @return @c true if the product have been computed, @c false otherwise
+   **/
+  static bool run(Lhs const& lhs, Rhs const& rhs, Result& res)
+  {
+    const int m = lhs.sizeRows(), n = rhs.sizeCols(), k = lhs.sizeCols();
+    if (m == 0 || n == 0 || k == 0) return false;
+    if (double(m)*double(n)*double(k) < double(blasMinSize_)) return false;
+    if (!BlasOperand<Lhs>::isContiguous(lhs) || !BlasOperand<Rhs>::isContiguous(rhs)) return false;
+    Real const* pa = BlasOperand<Lhs>::p_data(lhs);
+    Real const* pb = BlasOperand<Rhs>::p_data(rhs);
+    int lda = BlasOperand<Lhs>::ldx(lhs), ldb = BlasOperand<Rhs>::ldx(rhs);
+    int ldc = res.ldx();
+    Real* pc = Traits<Result>::orient_ ? res.p_data() + res.beginCols()*ldc + res.beginRows()
+                               : res.p_data() + res.beginRows()*ldc + res.beginCols();
+    // an operand stored by row is the transposed of an array stored by column
+    char ta = BlasOperand<Lhs>::orient_ ? 'N' : 'T';
+    char tb = BlasOperand<Rhs>::orient_ ? 'N' : 'T';
+    if (Traits<Result>::orient_) { gemm(ta, tb, m, n, k, pa, lda, pb, ldb, pc, ldc);}
+    else
+    {
+      // res^T = rhs^T lhs^T is stored by column
+      ta = (ta == 'N') ? 'T' : 'N';
+      tb = (tb == 'N') ? 'T' : 'N';
+      gemm(tb, ta, n, m, k, pb, ldb, pa, lda, pc, ldc);
+    }
+    return true;
+  }
+  /** wrapper of the gemm routine computing C = op(A) op(B) */
+  static void gemm( char ta, char tb, int m, int n, int k
+                  , Real const* pa, int lda, Real const* pb, int ldb
+                  , Real* pc, int ldc)
+  {
+    Real alpha = 1., beta = 0.;
+#ifdef STKREALAREFLOAT
+    sgemm_(&ta, &tb, &m, &n, &k, &alpha, const_cast<Real*>(pa), &lda
+          , const_cast<Real*>(pb), &ldb, &beta, pc, &ldc);
+#else
+    dgemm_(&ta, &tb, &m, &n, &k, &alpha, const_cast<Real*>(pa), &lda
+          , const_cast<Real*>(pb), &ldb, &beta, pc, &ldc);
+#endif
+  }
+};
+#endif // STKUSELAPACK
+
+} // namespace hidden
+
+} // namespace STK
+
+#endif /* STK_PRODUCTBLAS_H */
@@ -38,6 +38,8 @@
 #include "STK_ProductRaw.h"
 #include "STK_ArrayByVectorProduct.h"
 #include "STK_ArrayByArrayProduct.h"
+#include "STK_ProductKernel.h"
+#include "STK_ProductBlas.h"
 
 namespace STK
 {
@@ -401,8 +403,8 @@ struct ProductDispatcher<Lhs, Rhs, Result, Arrays::array2D_, Arrays::array2D_>
   static void run(Lhs const& lhs, Rhs const& rhs, Result& res )
   {
     if (MultCoefImpl<Lhs, Rhs, Result>::multDispatcher(lhs, rhs, res)) return;
-    (lhs.sizeRows()<rhs.sizeCols()) ? BlockByPanel<Lhs,Rhs,Result>::run(lhs, rhs, res)
-                                    : PanelByBlock<Lhs,Rhs,Result>::run(lhs, rhs, res);
+    if (BlasProduct<Lhs, Rhs, Result>::run(lhs, rhs, res)) return;
+    PackedProduct<Lhs,Rhs,Result>::run(lhs, rhs, res);
   }
 };
 
@@ -420,8 +422,8 @@ struct ProductDispatcher<Lhs, Rhs, Result, Arrays::array2D_, Arrays::square_>
   static void run(Lhs const& lhs, Rhs const& rhs, Result& res )
   {
     if (MultCoefImpl<Lhs, Rhs, Result>::multDispatcher(lhs, rhs, res)) return;
-    (lhs.sizeRows()<rhs.sizeCols()) ? BlockByPanel<Lhs,Rhs,Result>::run(lhs, rhs, res)
-                                    : PanelByBlock<Lhs,Rhs,Result>::run(lhs, rhs, res);
+    if (BlasProduct<Lhs, Rhs, Result>::run(lhs, rhs, res)) return;
+    PackedProduct<Lhs,Rhs,Result>::run(lhs, rhs, res);
   }
 };
 
@@ -439,8 +441,8 @@ struct ProductDispatcher<Lhs, Rhs, Result, Arrays::square_, Arrays::square_>
   static void run(Lhs const& lhs, Rhs const& rhs, Result& res )
   {
     if (MultCoefImpl<Lhs, Rhs, Result>::multDispatcher(lhs, rhs, res)) return;
-    (lhs.sizeRows()<rhs.sizeCols()) ? BlockByPanel<Lhs,Rhs,Result>::run(lhs, rhs, res)
-                                    : PanelByBlock<Lhs,Rhs,Result>::run(lhs, rhs, res);
+    if (BlasProduct<Lhs, Rhs, Result>::run(lhs, rhs, res)) return;
+    PackedProduct<Lhs,Rhs,Result>::run(lhs, rhs, res);
   }
 };
 
@@ -458,8 +460,8 @@ struct ProductDispatcher<Lhs, Rhs, Result, Arrays::square_, Arrays::array2D_>
   static void run(Lhs const& lhs, Rhs const& rhs, Result& res )
   {
     if (MultCoefImpl<Lhs, Rhs, Result>::multDispatcher(lhs, rhs, res)) return;
-    (lhs.sizeRows()<rhs.sizeCols()) ? BlockByPanel<Lhs,Rhs,Result>::run(lhs, rhs, res)
-                                    : PanelByBlock<Lhs,Rhs,Result>::run(lhs, rhs, res);
+    if (BlasProduct<Lhs, Rhs, Result>::run(lhs, rhs, res)) return;
+    PackedProduct<Lhs,Rhs,Result>::run(lhs, rhs, res);
   }
 };
 
@@ -0,0 +1,409 @@
+/*--------------------------------------------------------------------*/
+/*     Copyright (C) 2004-2016  Serge Iovleff, Université Lille 1, Inria
+
+    This program is free software; you can redistribute it and/or modify
+    it under the terms of the GNU Lesser General Public License as
+    published by the Free Software Foundation; either version 2 of the
+    License, or (at your option) any later version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU Lesser General Public License for more details.
+
+    You should have received a copy of the GNU Lesser General Public
+    License along with this program; if not, write to the
+    Free Software Foundation, Inc.,
+    59 Temple Place,
+    Suite 330,
+    Boston, MA 02111-1307
+    USA
+
+    Contact : S..._Dot_I..._At_stkpp_Dot_org (see copyright for ...)
+*/
+
+/*
+ * Project:  stkpp::Arrays
+ * Purpose:  Register blocked kernels for the products of arrays.
+ * Author:   iovleff, S..._Dot_I..._At_stkpp_Dot_org (see copyright for ...)
+ **/
+
+/** @file STK_ProductKernel.h
+ *  @brief In this file we implement the packed product of two arrays using
+ *  register blocked micro-kernels and cache blocking.
+ **/
+
+#ifndef STK_PRODUCTKERNEL_H
+#define STK_PRODUCTKERNEL_H
+
+#include <vector>
+#include <algorithm>
+#include <cstring>
+
+#if defined(__unix__) || defined(__APPLE__)
+#include <unistd.h>
+#endif
+
+/* size in bytes of the packets used by the micro-kernels and number of
+ * packets/columns of the tile they compute. The vector extensions of gcc and
+ * clang are lowered to the widest instruction set enabled at compile time. */
+#if defined(__GNUC__)
+#if defined(__AVX512F__)
+#define STK_PACKET_BYTES 64
+#define STK_KERNEL_MR_PACKETS 2
+#define STK_KERNEL_NR 12
+#elif defined(__AVX__)
+#define STK_PACKET_BYTES 32
+#define STK_KERNEL_MR_PACKETS 2
+#define STK_KERNEL_NR 6
+#else
+#define STK_PACKET_BYTES 16
+#define STK_KERNEL_MR_PACKETS 2
+#define STK_KERNEL_NR 6
+#endif
+#else
+#define STK_KERNEL_MR_PACKETS 4
+#define STK_KERNEL_NR 4
+#endif
+
+namespace STK
+{
+
+namespace hidden
+{
+/** @ingroup hidden
+ *  @return the size in bytes of the data cache of the given level (1, 2 or 3).
+ *  Default values are used if the size cannot be detected.
+ **/
+inline int cacheSize(int level)
+{
+  long size = -1;
+#if defined(_SC_LEVEL1_DCACHE_SIZE) && defined(_SC_LEVEL2_CACHE_SIZE) && defined(_SC_LEVEL3_CACHE_SIZE)
+  switch (level)
+  {
+    case 1: size = sysconf(_SC_LEVEL1_DCACHE_SIZE); break;
+    case 2: size = sysconf(_SC_LEVEL2_CACHE_SIZE); break;
+    case 3: size = sysconf(_SC_LEVEL3_CACHE_SIZE); break;
+    default: break;
+  }
+#endif
+  if (size <= 0) { size = (level == 1) ? 32768 : (level == 2) ? 262144 : 2097152;}
+  return (size > 1073741824) ? 1073741824 : int(size);
+}
+
+/** @ingroup hidden
+ *  Packet of Type used by the micro-kernels. By default a packet is a
+ *  single value.
+ **/
+template<class Type>
+struct PacketTraits
+{
+  typedef Type Packet;
+  enum { size_ = 1};
+  static Packet zero() { return Type(0);}
+  static Packet set1(Type const& v) { return v;}
+  static Packet load(Type const* p) { return *p;}
+  static void store(Type* p, Packet const& v) { *p = v;}
+};
+
+#if defined(STK_PACKET_BYTES)
+/** specialization for double */
+template<>
+struct PacketTraits<double>
+{
+  typedef double Packet __attribute__((vector_size(STK_PACKET_BYTES)));
+  enum { size_ = STK_PACKET_BYTES/sizeof(double)};
+  static Packet zero() { Packet v = {}; return v;}
+  static Packet set1(double v)
+  { Packet p = {}; for (int i=0; i<size_; ++i) { p[i] = v;} return p;}
+  static Packet load(double const* p)
+  { Packet v; std::memcpy(&v, p, sizeof(Packet)); return v;}
+  static void store(double* p, Packet const& v) { std::memcpy(p, &v, sizeof(Packet));}
+};
+/** specialization for float */
+template<>
+struct PacketTraits<float>
+{
+  typedef float Packet __attribute__((vector_size(STK_PACKET_BYTES)));
+  enum { size_ = STK_PACKET_BYTES/sizeof(float)};
+  static Packet zero() { Packet v = {}; return v;}
+  static Packet set1(float v)
+  { Packet p = {}; for (int i=0; i<size_; ++i) { p[i] = v;} return p;}
+  static Packet load(float const* p)
+  { Packet v; std::memcpy(&v, p, sizeof(Packet)); return v;}
+  static void store(float* p, Packet const& v) { std::memcpy(p, &v, sizeof(Packet));}
+};
+#endif
+
+/** @ingroup hidden
+ *  Micro-kernel computing a mr_ x nr_ tile of the product of a packed strip
+ *  of the lhs (mr_ rows) by a packed strip of the rhs (nr_ columns). The
+ *  accumulators are kept in registers during the whole inner loop.
+ **/
+template<class Type>
+struct MicroKernel
+{
+  typedef PacketTraits<Type> Pk;
+  typedef typename Pk::Packet Packet;
+  enum
+  {
+    mrPackets_ = STK_KERNEL_MR_PACKETS,
+    mr_ = STK_KERNEL_MR_PACKETS * Pk::size_,
+    nr_ = STK_KERNEL_NR
+  };
+  /** compute the tile c = a b, with c stored by column.
+   *  @param kc inner dimension
+   *  @param pa strip of the lhs: kc packed columns of size mr_
+   *  @param pb strip of the rhs: kc packed rows of size nr_
+   *  @param c array of size mr_ * nr_
+   **/
+  static void run(int kc, Type const* pa, Type const* pb, Type* c)
+  {
+    Packet acc[nr_][mrPackets_];
+    for (int j=0; j<nr_; ++j)
+      for (int i=0; i<mrPackets_; ++i) { acc[j][i] = Pk::zero();}
+    for (int p=0; p<kc; ++p, pa += mr_, pb += nr_)
+    {
+      Packet a[mrPackets_];
+      for (int i=0; i<mrPackets_; ++i) { a[i] = Pk::load(pa + i*Pk::size_);}
+      for (int j=0; j<nr_; ++j)
+      {
+        Packet const b = Pk::set1(pb[j]);
+        for (int i=0; i<mrPackets_; ++i) { acc[j][i] += a[i] * b;}
+      }
+    }
+    for (int j=0; j<nr_; ++j)
+      for (int i=0; i<mrPackets_; ++i) { Pk::store(c + j*mr_ + i*Pk::size_, acc[j][i]);}
+  }
+};
+
+/** @ingroup hidden
+ *  Buffer of at least size elements used by the calling thread for packing
+ *  an operand. The buffers of at most maxCachedBytes_ bytes are kept between
+ *  the calls in order to avoid the allocation of the packed operands at each
+ *  product. The larger ones (obtained with large blocking parameters) are
+ *  released at the end of the product, so that each thread does not keep
+ *  them alive.
+ **/
+template<class Type, int Id_>
+class PackBuffer
+{
+  public:
+    enum { maxCachedBytes_ = 4194304};
+    /** constructor
+     *  @param size the number of elements of the buffer
+     **/
+    explicit PackBuffer(int size): owned_(), p_data_(0)
+    {
+      if (size <= int(maxCachedBytes_/sizeof(Type)))
+      {
+        std::vector<Type>& buffer = cached();
+        if ((int)buffer.size() < size) { buffer.resize(size);}
+        p_data_ = buffer.data();
+      }
+      else
+      {
+        owned_.resize(size);
+        p_data_ = owned_.data();
+      }
+    }
+    /** @return a pointer on the first element of the buffer */
+    inline Type* data() const { return p_data_;}
+
+  private:
+    /** @return the buffer kept by the calling thread */
+    static std::vector<Type>& cached()
+    {
+      static thread_local std::vector<Type> buffer;
+      return buffer;
+    }
+    /** buffer released at the end of the product */
+    std::vector<Type> owned_;
+    /** pointer on the buffer used */
+    Type* p_data_;
+    /** forbidden copies */
+    PackBuffer(PackBuffer const&);
+    PackBuffer& operator=(PackBuffer const&);
+};
+
+} // namespace hidden
+
+/** @ingroup Arrays
+ *  @brief Cache blocking parameters of the native products.
+ *
+ *  The product C = AB is computed by blocks: panels of kc_ rows of B and
+ *  nc_ columns are packed in order to stay in the L3 cache, blocks of mc_
+ *  rows and kc_ columns of A are packed in order to stay in the L2 cache
+ *  and the strips used by the micro-kernel stay in the L1 cache. The
+ *  default values are computed from the cache sizes of the machine the
+ *  first time a product is computed. They can be modified by the user, but
+ *  not while a product is computed.
+ **/
+template<class Type>
+struct ProductBlocking
+{
+  enum
+  {
+    mr_ = hidden::MicroKernel<Type>::mr_,
+    nr_ = hidden::MicroKernel<Type>::nr_
+  };
+  /** depth of the packed panels */
+  int kc_;
+  /** number of rows of the packed blocks of the lhs */
+  int mc_;
+  /** number of columns of the packed panels of the rhs */
+  int nc_;
+  /** default constructor. Use the detected cache sizes */
+  ProductBlocking()
+  { setCacheSizes(hidden::cacheSize(1), hidden::cacheSize(2), hidden::cacheSize(3));}
+  /** compute the blocking parameters from the sizes in bytes of the caches */
+  void setCacheSizes(int l1, int l2, int l3)
+  {
+    const int s = sizeof(Type), kc = std::max(1, l1/((mr_+nr_)*s));
+    set(kc, (l2/2)/(kc*s), (l3/2)/(kc*s));
+  }
+  /** set the blocking parameters. The values are rounded and bounded. */
+  void set(int kc, int mc, int nc)
+  {
+    kc_ = std::max(16, std::min(1024, kc)); kc_ -= kc_%8;
+    mc_ = std::max(int(mr_), std::min(4096, mc)); mc_ -= mc_%mr_;
+    nc_ = std::max(int(nr_), std::min(8192, nc)); nc_ -= nc_%nr_;
+  }
+  /** @return the blocking parameters used by the products */
+  static ProductBlocking& instance()
+  {
+    static ProductBlocking blocking;
+    return blocking;
+  }
+};
+
+namespace hidden
+{
+/** @ingroup hidden
+ *  Methods to use for C=AB with A and B packed in the cache and the tiles
+ *  of C computed by the MicroKernel. The operands are accessed through
+ *  elt() when they are packed, so any kind of dense array or expression
+ *  can be used.
+ *  @note res have been resized and initialized to zero outside this method.
+ **/
+template<typename Lhs, typename Rhs, typename Result>
+struct PackedProduct
+{
+  typedef typename Result::Type Type;
+  typedef MicroKernel<Type> Kernel;
+  enum
+  {
+    mr_ = Kernel::mr_,
+    nr_ = Kernel::nr_
+  };
+
+  static void run(Lhs const& lhs, Rhs const& rhs, Result& res)
+  {
+#ifdef STK_ARRAYS_DEBUG
+     stk_cout << _T("Entering PackedProduct::run()\n");
+#endif
+    const int m = lhs.sizeRows(), n = rhs.sizeCols(), k = lhs.sizeCols();
+    if (m == 0 || n == 0 || k == 0) return;
+    ProductBlocking<Type> const& blocking = ProductBlocking<Type>::instance();
+    const int kc = std::min(k, blocking.kc_);
+    const int mc = std::min(roundUp(m, mr_), blocking.mc_);
+    const int nc = std::min(roundUp(n, nr_), blocking.nc_);
+    const int nbBlocks = (m + mc - 1)/mc;
+    PackBuffer<Type, 0> bufferB(kc * nc);
+    Type* pb = bufferB.data();
+    for (int jc = 0; jc < n; jc += nc)
+    {
+      const int ncur = std::min(nc, n - jc);
+      for (int pc = 0; pc < k; pc += kc)
+      {
+        const int kcur = std::min(kc, k - pc);
+        packRhs(rhs, pb, pc, jc, kcur, ncur);
+        if (nbBlocks > 1)
+        {
+#ifdef _OPENMP
+#pragma omp parallel for schedule(dynamic)
+#endif
+          for (int ib = 0; ib < nbBlocks; ++ib)
+          {
+            const int ic = ib * mc, mcur = std::min(mc, m - ic);
+            PackBuffer<Type, 1> bufferA(kcur * roundUp(mcur, mr_));
+            Type* pa = bufferA.data();
+            packLhs(lhs, pa, ic, pc, mcur, kcur);
+            multBlock(pa, pb, res, lhs.beginRows() + ic, rhs.beginCols() + jc, mcur, kcur, 0, ncur);
+          }
+        }
+        else
+        {
+          // a single block: the strips of the panel are shared between the threads
+          PackBuffer<Type, 1> bufferA(kcur * roundUp(m, mr_));
+          Type* pa = bufferA.data();
+          packLhs(lhs, pa, 0, pc, m, kcur);
+          const int nbStrips = (ncur + nr_ - 1)/nr_;
+#ifdef _OPENMP
+#pragma omp parallel for
+#endif
+          for (int s = 0; s < nbStrips; ++s)
+          { multBlock(pa, pb, res, lhs.beginRows(), rhs.beginCols() + jc, m, kcur, s*nr_, std::min(ncur, (s+1)*nr_));}
+        }
+      }
+    }
+  }
+  /** @return n rounded up to a multiple of r */
+  static int roundUp(int n, int r) { return ((n + r - 1)/r)*r;}
+  /** pack the block of the lhs with rows ic..ic+mcur and columns pc..pc+kcur
+   *  (relative positions) in strips of mr_ rows. Missing rows are set to zero. */
+  static void packLhs(Lhs const& lhs, Type* pa, int ic, int pc, int mcur, int kcur)
+  {
+    const int iBegin = lhs.beginRows() + ic, kBegin = lhs.beginCols() + pc;
+    for (int ir = 0; ir < mcur; ir += mr_)
+    {
+      const int mm = std::min(int(mr_), mcur - ir);
+      for (int p = 0; p < kcur; ++p, pa += mr_)
+      {
+        for (int i = 0; i < mm; ++i) { pa[i] = lhs.elt(iBegin + ir + i, kBegin + p);}
+        for (int i = mm; i < mr_; ++i) { pa[i] = Type(0);}
+      }
+    }
+  }
+  /** pack the panel of the rhs with rows pc..pc+kcur and columns jc..jc+ncur
+   *  (relative positions) in strips of nr_ columns. Missing columns are set to zero. */
+  static void packRhs(Rhs const& rhs, Type* pb, int pc, int jc, int kcur, int ncur)
+  {
+    const int kBegin = rhs.beginRows() + pc, jBegin = rhs.beginCols() + jc;
+    for (int jr = 0; jr < ncur; jr += nr_)
+    {
+      const int nn = std::min(int(nr_), ncur - jr);
+      for (int p = 0; p < kcur; ++p, pb += nr_)
+      {
+        for (int j = 0; j < nn; ++j) { pb[j] = rhs.elt(kBegin + p, jBegin + jr + j);}
+        for (int j = nn; j < nr_; ++j) { pb[j] = Type(0);}
+      }
+    }
+  }
+  /** compute the product of a packed block by the strips jBegin..jEnd of a
+   *  packed panel and add it to res. iRow and jCol are the position in res
+   *  of the block and of the panel. */
+  static void multBlock( Type const* pa, Type const* pb, Result& res
+                       , int iRow, int jCol, int mcur, int kcur, int jBegin, int jEnd)
+  {
+    Type c[mr_ * nr_];
+    for (int jr = jBegin; jr < jEnd; jr += nr_)
+    {
+      const int nn = std::min(int(nr_), jEnd - jr);
+      for (int ir = 0; ir < mcur; ir += mr_)
+      {
+        const int mm = std::min(int(mr_), mcur - ir);
+        Kernel::run(kcur, pa + ir * kcur, pb + jr * kcur, c);
+        for (int j = 0; j < nn; ++j)
+          for (int i = 0; i < mm; ++i)
+          { res.elt(iRow + ir + i, jCol + jr + j) += c[j * mr_ + i];}
+      }
+    }
+  }
+};
+
+} // namespace hidden
+
+} // namespace STK
+
+#endif /* STK_PRODUCTKERNEL_H */
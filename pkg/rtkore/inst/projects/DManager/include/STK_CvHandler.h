@@ -37,6 +37,9 @@
 #ifndef STK_CVHANDLER_H
 #define STK_CVHANDLER_H
 
+#include <vector>
+#include <exception>
+
 #include <Sdk.h>
 
 #include <Arrays/include/STK_CArrayVector.h>
@@ -48,6 +51,16 @@ namespace STK
 /** @ingroup DManager
  *  CvHanler is an utility function for building the submatrix/subvectors
  *  needed when using k-folds cross-validation.
+ *
+ *  The data of a fold can be either copied using getKFold, or accessed
+ *  without copy using the indexes of the rows returned by getKFoldIndexes
+ *  and the @c selectRows method of the arrays, e.g.
+ *  @code
+ *    CVectorXi learn, test;
+ *    handler.getKFoldIndexes(k, learn, test);
+ *    Real res = (x.selectRows(test) * beta - y.selectRows(test)).norm2();
+ *  @endcode
+ *  The runFolds method compute in parallel a criterion on each fold.
  **/
 class CvHandler: public IRunnerBase
 {
@@ -67,6 +80,10 @@ class CvHandler: public IRunnerBase
     inline CVectorXi const& partitions() const { return partitions_;}
     /** @return the size of the partitions */
     inline CVectorXi const& sizePartitions() const { return sizePartitions_;}
+    /** @return the criteria computed on each fold by runFolds */
+    inline CVectorX const& criteria() const { return criteria_;}
+    /** @return the sum of the criteria computed by runFolds */
+    inline Real criterion() const { return criterion_;}
 
     inline virtual bool run()
     { partition(); hasRun_ = true; return true;}
@@ -77,6 +94,8 @@ class CvHandler: public IRunnerBase
       nbFolds_ = nbFolds;
       partitions_.clear();
       sizePartitions_.clear();
+      criteria_.clear();
+      criterion_ = 0.;
       hasRun_ = false;
     }
     /** get the data set when setting out fold k and test data set  */
@@ -86,10 +105,33 @@ class CvHandler: public IRunnerBase
     template<class xData, class yData>
     bool getKFold( int k, xData const& x, xData& xFold, xData& xTest
                         , yData const& y, yData& yFold, yData& yTest);
+    /** get the indexes of the rows of the learning data set when setting out
+     *  fold k and the indexes of the rows of the test data set.
+     *  @param k the fold to set out
+     *  @param learn, test the indexes of the learning and test rows
+     **/
+    bool getKFoldIndexes( int k, CVectorXi& learn, CVectorXi& test);
+    /** Compute a criterion on each fold in parallel. The functor @c f is
+     *  called for each fold @c k with the signature
+     *  @code
+     *    Real f(int k, CVectorXi const& learn, CVectorXi const& test);
+     *  @endcode
+     *  where @c learn and @c test are the indexes of the learning and test
+     *  rows. The functor is called concurrently and should thus create its
+     *  own model for each fold. The results are available using the
+     *  criteria and criterion methods. If the functor throws an exception
+     *  on some folds, runFolds returns @c false and the error message of the
+     *  first fold which failed is available using the error method.
+     *  @param f the functor to call on each fold
+     **/
+    template<class Functor>
+    bool runFolds(Functor const& f);
 
   protected:
     /** create a random partition in k folds*/
     inline void partition();
+    /** fill the indexes of the learning and test rows of the fold k */
+    inline void fillKFoldIndexes( int k, CVectorXi& learn, CVectorXi& test) const;
 
   private:
     /** Range of the data set (number of rows) */
@@ -100,6 +142,10 @@ class CvHandler: public IRunnerBase
     CVectorXi partitions_;
     /** size of each fold */
     CVectorXi sizePartitions_;
+    /** criteria computed on each fold */
+    CVectorX criteria_;
+    /** sum of the criteria */
+    Real criterion_;
 };
 
 /* Default constructor. nbFolds is set to the number of observation
@@ -110,6 +156,7 @@ inline CvHandler::CvHandler( Range const& rangeData, int nbFolds)
                            : IRunnerBase()
                            , rangeData_(rangeData), nbFolds_(nbFolds)
                            , partitions_(), sizePartitions_()
+                           , criteria_(), criterion_(0.)
 {
   // check nbFolds parameter
   if (nbFolds_<1)
@@ -215,6 +262,79 @@ bool CvHandler::getKFold( int k, xData const& x, xData& xFold, xData& xTest
   return true;
 }
 
+/* get the indexes of the learning and test rows when setting out fold k */
+inline bool CvHandler::getKFoldIndexes( int k, CVectorXi& learn, CVectorXi& test)
+{
+  // check if partitions are determined
+  if (!hasRun_)
+  { msg_error_ = STKERROR_NO_ARG(CvHandler::getKFoldIndexes,CvHandler has to run);
+    return false;
+  }
+  if (sizePartitions_.begin() > k)
+  { msg_error_ = STKERROR_1ARG(CvHandler::getKFoldIndexes,k,k<sizePartitions_.begin());
+    return false;
+  }
+  if (sizePartitions_.end() <= k)
+  { msg_error_ = STKERROR_1ARG(CvHandler::getKFoldIndexes,k,k<sizePartitions_.end()<=k);
+    return false;
+  }
+  fillKFoldIndexes(k, learn, test);
+  return true;
+}
+/* Compute a criterion on each fold in parallel */
+template<class Functor>
+bool CvHandler::runFolds(Functor const& f)
+{
+  if (!hasRun_) { run();}
+  criteria_.resize(sizePartitions_.range()) = 0.;
+  criterion_ = 0.;
+  CVectorXi failed(sizePartitions_.range(), 0);
+  std::vector<String> errors(sizePartitions_.size());
+  const int first = sizePartitions_.begin(), last = sizePartitions_.end();
+#ifdef _OPENMP
+#pragma omp parallel for schedule(dynamic)
+#endif
+  for (int k = first; k < last; ++k)
+  {
+    // no exception can leave the parallel region
+    try
+    {
+      CVectorXi learn, test;
+      fillKFoldIndexes(k, learn, test);
+      criteria_[k] = f(k, learn, test);
+    }
+    catch (Exception const& e)
+    { failed[k] = 1; errors[k - first] = e.error();}
+    catch (std::exception const& e)
+    { failed[k] = 1; errors[k - first] = e.what();}
+    catch (...)
+    { failed[k] = 1; errors[k - first] = _T("unknown error");}
+  }
+  // report the error of the first fold which failed
+  for (int k = first; k < last; ++k)
+  {
+    if (failed[k])
+    { msg_error_ = STKERROR_1ARG(CvHandler::runFolds,k,computation failed on fold);
+      msg_error_ += _T("\n") + errors[k - first];
+      return false;
+    }
+  }
+  criterion_ = criteria_.sum();
+  return true;
+}
+/* fill the indexes of the learning and test rows of the fold k */
+inline void CvHandler::fillKFoldIndexes( int k, CVectorXi& learn, CVectorXi& test) const
+{
+  learn.resize(partitions_.size() - sizePartitions_[k]);
+  test.resize(sizePartitions_[k]);
+  int iLearn = learn.begin(), iTest = test.begin();
+  for (int i = partitions_.begin(); i < partitions_.end(); ++i)
+  {
+    if (partitions_[i] == k) { test[iTest] = i; ++iTest;}
+    else                     { learn[iLearn] = i; ++iLearn;}
+  }
+}
+
 /* create a random partition in k folds*/
 inline void CvHandler::partition()
 {
@@ -37,6 +37,7 @@
 #define STK_DATAHANDLER_H
 
 #include <vector>
+#include <map>
 #include <Arrays/include/STK_Array2D.h>
 
 #include "STK_DataHandlerBase.h"
@@ -58,19 +59,59 @@ struct DataHandlerTraits<DataHandler, Type>
   typedef Array2D<Type> Data;
 };
 
+/** @ingroup hidden
+ *  Give the type used by DataHandler for storing a data set of type @c Type:
+ *  @c Real or @c int for the numeric data sets and @c String otherwise.
+ **/
+template<typename Type>
+struct DataHandlerStore
+{
+  typedef typename RemoveConst<Type>::Type Type_;
+  typedef typename If< isSame<Type_, Real>::value_, Real
+                     , typename If< isSame<Type_, int>::value_, int, String>::Result
+                     >::Result Result;
+};
+
+/** @ingroup hidden
+ *  Convert a value stored by DataHandler in the type @c Type, the missing
+ *  values are preserved.
+ **/
+template<typename Type>
+struct DataHandlerCast
+{
+  template<typename Stored>
+  static Type run(Stored const& x)
+  { return Arithmetic<Stored>::isNA(x) ? Arithmetic<Type>::NA() : static_cast<Type>(x);}
+};
+/** @ingroup hidden
+ *  Specialization of DataHandlerCast for String
+ **/
+template<>
+struct DataHandlerCast<String>
+{
+  template<typename Stored>
+  static String run(Stored const& x) { return typeToString(x);}
+};
+
 } // namespace hidden
 
 /** @ingroup DManager
  *  @c implementation of the DataHandlerBase class using ReadWriteCsv and Array2D.
  *  The DataHandler class allow to read various csv files with their description
  *  files and to get the columns identified by an idData in an @c Array2D.
- *  All data are stored in memory in a ReadWriteCsv structure.
+ *  The data read from csv files are stored in memory in a ReadWriteCsv
+ *  structure. The numeric data sets given as arrays are stored column-wise
+ *  in their (@c Real or @c int) type, missing values are stored as NA values.
  */
 class DataHandler: public DataHandlerBase<DataHandler>
 {
   public:
     typedef DataHandlerBase<DataHandler> Base;
     typedef DataHandlerBase<DataHandler>::InfoMap InfoMap;
+    /** type of the store of the data sets with real values */
+    typedef std::map<std::string, Array2D<Real> > RealStore;
+    /** type of the store of the data sets with integer values */
+    typedef std::map<std::string, Array2D<int> > IntStore;
     /** default constructor */
     inline DataHandler(): Base(), withNames_(false)
     { data_.setWithNames(false); descriptor_.setWithNames(false);}
@@ -80,10 +121,14 @@ class DataHandler: public DataHandlerBase<DataHandler>
     inline ReadWriteCsv const& data() const { return data_;}
     /** get the whole descriptor set */
     inline ReadWriteCsv const& descriptor() const { return descriptor_;}
+    /** get the data sets with real values */
+    inline RealStore const& realData() const { return realData_;}
+    /** get the data sets with integer values */
+    inline IntStore const& intData() const { return intData_;}
     /** @return the number of sample (the number of rows of the data) */
-    inline int nbSample() const { return data_.sizeRows();}
-    /** @return the number of sample (the number of columns of the data) */
-    inline int nbVariable() const { return data_.size();}
+    int nbSample() const;
+    /** @return the number of variables (the number of columns of the data) */
+    int nbVariable() const;
 
     /** set withNames flag */
     inline void setWithNames(bool withNames) { withNames_ = withNames;}
@@ -97,10 +142,8 @@ class DataHandler: public DataHandlerBase<DataHandler>
      **/
     bool readDataFromCsvFile(std::string const& datafile, std::string const& idData, std::string const& idModel);
     /** @brief read a data set from an Array2D.
-     * This method should be essentially used:
-     * - for testing some statistical method as the data  will be converted in a
-     * String format (whcih is not an efficient way to store the data..).
-     * - if the data are already stored in a String format.
+     * The numeric data are stored in their type (@c Real or @c int), the
+     * other data are converted in a String format.
      * @param data the data set
      * @param idData the id of the data
      * @param idModel an id identifying the model to use with the data set
@@ -108,22 +151,43 @@ class DataHandler: public DataHandlerBase<DataHandler>
     template<typename Type>
     bool readDataFromArray2D(Array2D<Type> const& data, std::string const& idData, std::string const& idModel);
     /** @brief read a data set from an Array or Expression.
-     * This method should be essentially used:
-     * - for testing some statistical method as the data  will be converted in a
-     * String format (whcih is not an efficient way to store the data..).
-     * - if the data are already stored in a String format.
+     * The numeric data are stored in their type (@c Real or @c int), the
+     * other data are converted in a String format.
      * @param data the data set
      * @param idData the id of the data
      * @param idModel an id identifying the model to use with the data set
      **/
     template<typename Array>
     bool readDataFromArray(ExprBase<Array> const& data, std::string const& idData, std::string const& idModel);
-    /** @return in an Array2D<Type> the data with the given idData */
+    /** @return in an Array2D<Type> the data with the given idData
+     *  @sa getData(std::string const&, Array2D<Type>&, int&)
+     **/
     template<typename Type>
     void getData(std::string const& idData, Array2D<Type>& data) const;
-    /** @return in an Array2D<Type> the data with the given idData */
+    /** @brief get the data with the given idData.
+     *  If the data set is stored in the type @c Type and has no missing
+     *  values, @c data is a reference on the stored data and no copy is done:
+     *  the handler must then outlive @c data and the data set must not be
+     *  read again. Otherwise @c data is a (converted) copy of the data set, as
+     *  the mixtures impute the missing values in place.
+     *  @param idData id of the data to get
+     *  @param data the data set
+     *  @param nbVariable the number of columns of the data set
+     **/
     template<typename Type>
     void getData(std::string const& idData, Array2D<Type>& data, int& nbVariable) const;
+    /** @brief get a view on the real data with the given idData without copy.
+     *  The view is a reference on the stored data and must not be modified.
+     *  @param idData id of the data to get
+     *  @param view the reference on the data
+     *  @return @c true if there is a real data set with this idData,
+     *  @c false otherwise
+     **/
+    bool getDataView(std::string const& idData, Array2D<Real>& view) const;
+    /** @brief get a view on the integer data with the given idData without copy.
+     *  @sa getDataView(std::string const&, Array2D<Real>&)
+     **/
+    bool getDataView(std::string const& idData, Array2D<int>& view) const;
     /** remove the data with the given idData */
     void removeData(std::string const& idData);
 
@@ -135,6 +199,31 @@ class DataHandler: public DataHandlerBase<DataHandler>
     std::vector<int> colIndex(std::string const& idData) const;
 
   private:
+    /** store a data set with real values */
+    template<class Array>
+    void storeData(ExprBase<Array> const& data, std::string const& idData, Real*);
+    /** store a data set with integer values */
+    template<class Array>
+    void storeData(ExprBase<Array> const& data, std::string const& idData, int*);
+    /** store a data set in a String format */
+    template<class Array>
+    void storeData(ExprBase<Array> const& data, std::string const& idData, String*);
+    /** reference a stored data set if it has no missing values
+     *  @return @c true if @c data is a reference on @c source
+     **/
+    template<typename Type>
+    static bool referenceData(Array2D<Type> const& source, Array2D<Type>& data);
+    /** a stored data set of an other type cannot be referenced */
+    template<typename Stored, typename Type>
+    static bool referenceData(Array2D<Stored> const& source, Array2D<Type>& data)
+    { return false;}
+    /** copy and convert a data set preserving the missing values */
+    template<class Array, typename Type>
+    static void copyData(ExprBase<Array> const& source, Array2D<Type>& data);
+    /** add the columns of a data set to a stored data set */
+    template<class Array, typename Type>
+    static void appendData(ExprBase<Array> const& source, Array2D<Type>& data);
+
     /** first line with names ?*/
     bool withNames_;
     /** data files */
@@ -143,12 +232,97 @@ class DataHandler: public DataHandlerBase<DataHandler>
      * on the second row, we get the idData
      **/
     ReadWriteCsv descriptor_;
+    /** data sets with real values */
+    RealStore realData_;
+    /** data sets with integer values */
+    IntStore intData_;
 };
 
+inline int DataHandler::nbSample() const
+{
+  if (data_.size() > 0) return data_.sizeRows();
+  if (!realData_.empty()) return realData_.begin()->second.sizeRows();
+  if (!intData_.empty()) return intData_.begin()->second.sizeRows();
+  return 0;
+}
+
+inline int DataHandler::nbVariable() const
+{
+  int nbVariable = data_.size();
+  for (RealStore::const_iterator it = realData_.begin(); it != realData_.end(); ++it)
+  { nbVariable += it->second.sizeCols();}
+  for (IntStore::const_iterator it = intData_.begin(); it != intData_.end(); ++it)
+  { nbVariable += it->second.sizeCols();}
+  return nbVariable;
+}
+
+inline void DataHandler::removeData(std::string const& idData)
+{
+  realData_.erase(idData);
+  intData_.erase(idData);
+  // remove the columns of the csv data in reverse order
+  std::vector<int> indexes = colIndex(idData);
+  for (std::vector<int>::const_reverse_iterator it = indexes.rbegin(); it != indexes.rend(); ++it)
+  { data_.eraseColumn(*it); descriptor_.eraseColumn(*it);}
+  info_.erase(idData);
+}
+
+inline bool DataHandler::getDataView(std::string const& idData, Array2D<Real>& view) const
+{
+  RealStore::const_iterator it = realData_.find(idData);
+  if (it == realData_.end()) return false;
+  view.move(Array2D<Real>(it->second, true));
+  return true;
+}
+
+inline bool DataHandler::getDataView(std::string const& idData, Array2D<int>& view) const
+{
+  IntStore::const_iterator it = intData_.find(idData);
+  if (it == intData_.end()) return false;
+  view.move(Array2D<int>(it->second, true));
+  return true;
+}
+
+template<typename Type>
+bool DataHandler::referenceData(Array2D<Type> const& source, Array2D<Type>& data)
+{
+  for (int j = source.beginCols(); j < source.endCols(); ++j)
+  {
+    for (int i = source.beginRows(); i < source.endRows(); ++i)
+    { if (Arithmetic<Type>::isNA(source.elt(i, j))) return false;}
+  }
+  data.move(Array2D<Type>(source, true));
+  return true;
+}
+
+template<class Array, typename Type>
+void DataHandler::copyData(ExprBase<Array> const& source, Array2D<Type>& data)
+{
+  data.resize(source.rows(), source.cols());
+  for (int j = source.beginCols(); j < source.endCols(); ++j)
+  {
+    for (int i = source.beginRows(); i < source.endRows(); ++i)
+    { data(i, j) = hidden::DataHandlerCast<Type>::run(source.elt(i, j));}
+  }
+}
 
 template<typename Type>
 void DataHandler::getData(std::string const& idData, Array2D<Type>& data, int& nbVariable) const
 {
+  RealStore::const_iterator itReal = realData_.find(idData);
+  if (itReal != realData_.end())
+  {
+    if (!referenceData(itReal->second, data)) { copyData(itReal->second, data);}
+    nbVariable = data.sizeCols();
+    return;
+  }
+  IntStore::const_iterator itInt = intData_.find(idData);
+  if (itInt != intData_.end())
+  {
+    if (!referenceData(itInt->second, data)) { copyData(itInt->second, data);}
+    nbVariable = data.sizeCols();
+    return;
+  }
   std::vector<int> indexes = colIndex(idData);
 #ifdef STK_MIXTURE_VERY_VERBOSE
   stk_cout << _T("In DataHandler::getData, idData = ") << idData << _T("\n");
@@ -170,55 +344,55 @@ void DataHandler::getData(std::string const& idData, Array2D<Type>& data, int& n
 template<typename Type>
 void DataHandler::getData(std::string const& idData, Array2D<Type>& data) const
 {
-  std::vector<int> indexes = colIndex(idData);
-#ifdef STK_MIXTURE_VERY_VERBOSE
-  stk_cout << _T("In DataHandler::getData, idData = ") << idData << _T("\n");
-  stk_cout << _T("columns found = ");
-  for (std::vector<int>::const_iterator it = indexes.begin(); it != indexes.end(); ++it)
-  { stk_cout << (*it) << _T(" ");}
-  stk_cout << _T("\n");
-#endif
-  int nbVariable = indexes.size();
-  data.resize(nbSample(), nbVariable);
-  int j= data.beginCols();
-  for (std::vector<int>::const_iterator it = indexes.begin(); it != indexes.end(); ++it, ++j)
-  {
-    for (int i = data_.firstRow(*it); i <= data_.lastRow(*it); ++i)
-    { data(i, j) = stringToType<Type>(data_(i,*it));}
-  }
+  int nbVariable;
+  getData(idData, data, nbVariable);
 }
 
 template<typename Type>
 bool DataHandler::readDataFromArray2D( Array2D<Type> const& data
                                      , std::string const& idData
                                      , std::string const& idModel)
+{ return readDataFromArray(data, idData, idModel);}
+
+template<typename Array>
+bool DataHandler::readDataFromArray( ExprBase<Array> const& data
+                                   , std::string const& idData
+                                   , std::string const& idModel)
 {
-  // add descriptor
-  Variable<std::string> desc(2, stringNa);
-  desc[baseIdx] = idModel ; desc[baseIdx+1] = idData;
+  typedef typename hidden::DataHandlerStore<typename Array::Type>::Result Stored;
   if (!addInfo(idData, idModel)) return false;
-  // store data at the end of the ReadWriteCsv array in a string format
-  for (int j=data.beginCols(); j<= data.lastIdxCols(); ++j)
+  storeData(data, idData, (Stored*)0);
+  return true;
+}
+
+template<class Array>
+void DataHandler::storeData(ExprBase<Array> const& data, std::string const& idData, Real*)
+{ appendData(data, realData_[idData]);}
+
+template<class Array>
+void DataHandler::storeData(ExprBase<Array> const& data, std::string const& idData, int*)
+{ appendData(data, intData_[idData]);}
+
+template<class Array, typename Type>
+void DataHandler::appendData(ExprBase<Array> const& source, Array2D<Type>& data)
+{
+  if (data.empty()) { copyData(source, data); return;}
+  // the columns are added at the end of the existing data set
+  int first = data.endCols();
+  data.pushBackCols(source.sizeCols());
+  for (int j = source.beginCols(), jData = first; j < source.endCols(); ++j, ++jData)
   {
-    data_.push_back();
-    data_.back().resize(data.rows());
-    for (int i= data.beginRows(); i < data.endRows(); ++i)
-    { data_.back()[i] = typeToString(data(i,j), std::scientific);}
-    // store descriptor : this is the same for all the columns added
-    descriptor_.push_back(desc);
+    for (int i = source.beginRows(); i < source.endRows(); ++i)
+    { data(i, jData) = hidden::DataHandlerCast<Type>::run(source.elt(i, j));}
   }
-  return true;
 }
 
-template<typename Array>
-bool DataHandler::readDataFromArray( ExprBase<Array> const& data
-                                   , std::string const& idData
-                                   , std::string const& idModel)
+template<class Array>
+void DataHandler::storeData(ExprBase<Array> const& data, std::string const& idData, String*)
 {
   // add descriptor
   Variable<std::string> desc(2, stringNa);
-  desc[baseIdx] = idModel ; desc[baseIdx+1] = idData;
-  if (!addInfo(idData, idModel)) return false;
+  desc[baseIdx] = info_[idData] ; desc[baseIdx+1] = idData;
   // store data at the end of the ReadWriteCsv array in a string format
   for (int j=data.beginCols(); j<= data.lastIdxCols(); ++j)
   {
@@ -229,10 +403,8 @@ bool DataHandler::readDataFromArray( ExprBase<Array> const& data
     // store descriptor : this is the same for all the columns added
     descriptor_.push_back(desc);
   }
-  return true;
 }
 
-
 } // namespace STK
 
 #endif /* STK_DATAHANDLER_H */
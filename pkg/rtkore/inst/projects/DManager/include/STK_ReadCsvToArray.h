@@ -0,0 +1,518 @@
+/*--------------------------------------------------------------------*/
+/*     Copyright (C) 2004-2016  Serge Iovleff, Université Lille 1, Inria
+
+ This program is free software; you can redistribute it and/or modify
+ it under the terms of the GNU Lesser General Public License as
+ published by the Free Software Foundation; either version 2 of the
+ License, or (at your option) any later version.
+
+ This program is distributed in the hope that it will be useful,
+ but WITHOUT ANY WARRANTY; without even the implied warranty of
+ MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ GNU Lesser General Public License for more details.
+
+ You should have received a copy of the GNU Lesser General Public
+ License along with this program; if not, write to the
+ Free Software Foundation, Inc.,
+ 59 Temple Place,
+ Suite 330,
+ Boston, MA 02111-1307
+ USA
+
+ Contact : S..._Dot_I..._At_stkpp_Dot_org (see copyright for ...)
+ */
+
+/*
+ * Project:  stkpp::DManager
+ * Purpose:  Read a numeric csv file directly in an Array.
+ * Author:   iovleff, S..._Dot_I..._At_stkpp_Dot_org (see copyright for ...)
+ *
+ **/
+
+/** @file STK_ReadCsvToArray.h
+ *  @brief In this file we define the ReadCsvToArray class.
+ **/
+
+#ifndef STK_READCSVTOARRAY_H
+#define STK_READCSVTOARRAY_H
+
+#include <vector>
+#include <cstdlib>
+#include <cstring>
+#include <cmath>
+#include <cerrno>
+#include <fstream>
+
+#if defined(__unix__) || defined(__APPLE__)
+#define STK_CSV_MMAP
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <fcntl.h>
+#include <unistd.h>
+#endif
+
+#ifdef _OPENMP
+#include <omp.h>
+#endif
+
+#include "STK_ReadWriteCsv.h"
+
+namespace STK
+{
+namespace hidden
+{
+/** @ingroup hidden
+ *  Read only access to the content of a whole file. On posix systems the
+ *  file is mapped in memory, otherwise it is read in a buffer.
+ **/
+class CsvFileBuffer
+{
+  public:
+    /** default constructor */
+    inline CsvFileBuffer(): p_begin_(0), size_(0), isMapped_(false) {}
+    /** destructor */
+    inline ~CsvFileBuffer() { close();}
+    /** @return the first character of the file */
+    inline char const* begin() const { return p_begin_;}
+    /** @return the end of the file */
+    inline char const* end() const { return p_begin_ + size_;}
+    /** open the file
+     *  @param file_name name of the file to open
+     *  @return @c false if the file cannot be read, @c true otherwise
+     **/
+    bool open(std::string const& file_name);
+    /** release the file */
+    void close();
+
+  private:
+    /** first character of the file */
+    char const* p_begin_;
+    /** size of the file */
+    size_t size_;
+    /** @c true if the file is mapped in memory */
+    bool isMapped_;
+    /** buffer used if the file is not mapped */
+    std::vector<char> buffer_;
+    /** forbidden copies */
+    CsvFileBuffer(CsvFileBuffer const&);
+    CsvFileBuffer& operator=(CsvFileBuffer const&);
+};
+
+inline bool CsvFileBuffer::open(std::string const& file_name)
+{
+  close();
+#ifdef STK_CSV_MMAP
+  int fd = ::open(file_name.c_str(), O_RDONLY);
+  if (fd < 0) return false;
+  struct stat st;
+  if (::fstat(fd, &st) == 0 && st.st_size > 0)
+  {
+    void* p = ::mmap(0, st.st_size, PROT_READ, MAP_PRIVATE, fd, 0);
+    if (p != MAP_FAILED)
+    {
+      ::madvise(p, st.st_size, MADV_SEQUENTIAL);
+      p_begin_ = static_cast<char const*>(p);
+      size_ = st.st_size;
+      isMapped_ = true;
+    }
+  }
+  ::close(fd);
+  if (isMapped_) return true;
+#endif
+  // fallback: read the whole file in a buffer
+  std::ifstream inFile(file_name.c_str(), std::ios::in | std::ios::binary);
+  if (!inFile) return false;
+  inFile.seekg(0, std::ios::end);
+  std::streamoff size = inFile.tellg();
+  inFile.seekg(0, std::ios::beg);
+  if (size > 0)
+  {
+    buffer_.resize(size);
+    inFile.read(&buffer_[0], size);
+    p_begin_ = &buffer_[0];
+    size_ = inFile.gcount();
+  }
+  return true;
+}
+
+inline void CsvFileBuffer::close()
+{
+#ifdef STK_CSV_MMAP
+  if (isMapped_) { ::munmap(const_cast<char*>(p_begin_), size_);}
+#endif
+  std::vector<char>().swap(buffer_);
+  p_begin_ = 0; size_ = 0; isMapped_ = false;
+}
+
+/** @ingroup hidden
+ *  Parse without allocation the field [first, last) of a csv file.
+ *  Fields which are not numbers are NA values. Numbers which cannot be
+ *  represented in the type are NA values too and set the flag
+ *  @c outOfRange to @c true.
+ **/
+template<typename Type> struct CsvParserImpl;
+
+/** @ingroup hidden
+ *  Specialization of CsvParserImpl for Real.
+ **/
+template<>
+struct CsvParserImpl<Real>
+{
+  static Real run(char const* first, char const* last, bool& outOfRange)
+  {
+    outOfRange = false;
+    static const Real pow10[] = { 1e0, 1e1, 1e2, 1e3, 1e4, 1e5, 1e6, 1e7, 1e8, 1e9, 1e10, 1e11
+                                , 1e12, 1e13, 1e14, 1e15, 1e16, 1e17, 1e18, 1e19, 1e20, 1e21, 1e22};
+    if (first == last) return Arithmetic<Real>::NA();
+    char const* p = first;
+    bool neg = (*p == '-');
+    if (*p == '-' || *p == '+') ++p;
+    // significant digits, the exact fast path is used with at most 15 digits
+    unsigned long long mant = 0;
+    int nbDigit = 0, exp10 = 0;
+    bool hasDigit = false;
+    for (; p != last && *p >= '0' && *p <= '9'; ++p)
+    {
+      hasDigit = true;
+      if (mant == 0 && *p == '0') continue;
+      if (nbDigit < 19) { mant = 10*mant + (*p - '0'); ++nbDigit;} else { ++exp10;}
+    }
+    if (p != last && *p == '.')
+    {
+      for (++p; p != last && *p >= '0' && *p <= '9'; ++p)
+      {
+        hasDigit = true;
+        if (mant == 0 && *p == '0') { --exp10; continue;}
+        if (nbDigit < 19) { mant = 10*mant + (*p - '0'); ++nbDigit; --exp10;}
+      }
+    }
+    if (hasDigit && p != last && (*p == 'e' || *p == 'E'))
+    {
+      char const* q = p+1;
+      bool negExp = (q != last && *q == '-');
+      if (q != last && (*q == '-' || *q == '+')) ++q;
+      if (q != last && *q >= '0' && *q <= '9')
+      {
+        int e = 0;
+        for (; q != last && *q >= '0' && *q <= '9'; ++q) { if (e < 100000) e = 10*e + (*q - '0');}
+        exp10 += negExp ? -e : e;
+        p = q;
+      }
+    }
+    if (hasDigit && p == last && nbDigit <= 15)
+    {
+      if (mant == 0) return neg ? -0. : 0.;
+      if (exp10 >= -22 && exp10 <= 22)
+      {
+        Real value = (exp10 < 0) ? Real(mant)/pow10[-exp10] : Real(mant)*pow10[exp10];
+        return neg ? -value : value;
+      }
+    }
+    // slow path (long mantissa, large exponent, inf, ...): use strtod
+    char buffer[64];
+    size_t size = last - first;
+    if (size >= sizeof(buffer)) return Arithmetic<Real>::NA();
+    std::memcpy(buffer, first, size);
+    buffer[size] = 0;
+    char* end;
+    errno = 0;
+    Real value = std::strtod(buffer, &end);
+    if (end != buffer + size) return Arithmetic<Real>::NA();
+    // overflow (the underflows are rounded to zero or to a denormal)
+    if (errno == ERANGE && std::abs(value) > 1.)
+    {
+      outOfRange = true;
+      return Arithmetic<Real>::NA();
+    }
+    return value;
+  }
+};
+
+/** @ingroup hidden
+ *  Specialization of CsvParserImpl for int.
+ **/
+template<>
+struct CsvParserImpl<int>
+{
+  static int run(char const* first, char const* last, bool& outOfRange)
+  {
+    outOfRange = false;
+    if (first == last) return Arithmetic<int>::NA();
+    char const* p = first;
+    bool neg = (*p == '-');
+    if (*p == '-' || *p == '+') ++p;
+    if (p == last) return Arithmetic<int>::NA();
+    // the smallest int is the NA value, so the valid integers are in
+    // [-max, max] and the literal of the smallest int is out of range
+    long long value = 0;
+    for (; p != last && *p >= '0' && *p <= '9'; ++p)
+    {
+      if (value <= std::numeric_limits<int>::max()) value = 10*value + (*p - '0');
+    }
+    if (p == last)
+    {
+      if (value <= std::numeric_limits<int>::max()) return int(neg ? -value : value);
+      outOfRange = true;
+      return Arithmetic<int>::NA();
+    }
+    // integer written as a real number (like 1.0 or 1e2)
+    bool realOutOfRange;
+    Real x = CsvParserImpl<Real>::run(first, last, realOutOfRange);
+    if (realOutOfRange) { outOfRange = true; return Arithmetic<int>::NA();}
+    if (!Arithmetic<Real>::isFinite(x) || x != std::floor(x)) return Arithmetic<int>::NA();
+    if (std::abs(x) <= std::numeric_limits<int>::max()) return int(x);
+    outOfRange = true;
+    return Arithmetic<int>::NA();
+  }
+};
+
+} // namespace hidden
+
+/** @ingroup DManager
+ *  @brief The ReadCsvToArray class allow to read a csv file with numeric
+ *  data (@c Real or @c int) directly in an @c Array.
+ *
+ *  The file is mapped in memory and split in chunks of complete lines. The
+ *  chunks are processed in parallel: a first pass count the rows and the
+ *  fields of each chunk, a second pass parse the fields in place and store
+ *  the values in the Array. Fields which are not numbers are NA values, rows
+ *  with less fields than the number of columns are completed with NA values
+ *  and blank lines are skipped as in TReadWriteCsv. Numbers which cannot be
+ *  represented in the type of the Array (like the integers out of the range
+ *  of int or the literal of the smallest int, which is the NA value) are
+ *  read as NA values and counted by nbOutOfRange().
+ *
+ *  Only the numeric files are read by this class, TReadWriteCsv<Real> and
+ *  TReadWriteCsv<int> use it when no mapping is set.
+ *
+ *  The Array container is created on the heap and will be deleted with the
+ *  @c ReadCsvToArray structure. It is possible to release the Array container
+ *  by calling explicitly the @c release() method. In this case the end user
+ *  will have to free it directly.
+ */
+template<class Array>
+class ReadCsvToArray: public IRunnerBase
+{
+  public:
+    typedef typename Array::Type Type;
+    /** Constructor
+     *  @param file_name name of the file to read
+     *  @param delimiters the delimiters of the fields
+     *  @param withNames @c true if the first line contains the names of the variables
+     */
+    ReadCsvToArray( std::string const& file_name
+                  , String const& delimiters = Csv::DEFAULT_DELIMITER
+                  , bool withNames = Csv::DEFAULT_READNAMES
+                  )
+                  : IRunnerBase(), file_name_(file_name), delimiters_(delimiters)
+                  , withNames_(withNames), names_(), nbOutOfRange_(0), p_data_(0)
+    {}
+    /** copy constructor. The data are not copied.
+     *  @param reader the ReadCsvToArray to copy
+     */
+    ReadCsvToArray( ReadCsvToArray const& reader)
+                  : IRunnerBase(reader), file_name_(reader.file_name_), delimiters_(reader.delimiters_)
+                  , withNames_(reader.withNames_), names_(), nbOutOfRange_(0), p_data_(0)
+    {}
+    /** destructor */
+    virtual ~ReadCsvToArray() { if (p_data_) delete p_data_;}
+    /** clone pattern */
+    ReadCsvToArray* clone() const { return new ReadCsvToArray(*this);}
+    /** @return the names of the variables */
+    inline std::vector<String> const& names() const { return names_;}
+    /** @return the number of numbers read as NA as they cannot be represented */
+    inline int nbOutOfRange() const { return nbOutOfRange_;}
+    /** set the delimiters of the fields */
+    inline void setDelimiters(String const& delimiters) { delimiters_ = delimiters;}
+    /** set the withNames flag */
+    inline void setWithNames(bool withNames) { withNames_ = withNames;}
+    /** read the file. */
+    virtual bool run();
+    /** Accessor. get the Array. This method is not constant
+     *  in order to allow to the user to modify directly the 2D container.
+     *  @return a ptr on the 2D container constructed
+     **/
+    inline Array* p_data() { return p_data_;}
+    /** release the Array. It will be freed by the user. */
+    inline void release() { p_data_ =0;}
+
+  private:
+    /** name of the file to read */
+    std::string file_name_;
+    /** delimiters of the fields */
+    String delimiters_;
+    /** @c true if the names of the variables are in the first line */
+    bool withNames_;
+    /** names of the variables */
+    std::vector<String> names_;
+    /** number of numbers out of the range of Type */
+    int nbOutOfRange_;
+    /** A pointer on the 2D Container the class will create. */
+    Array* p_data_;
+    /** table of the delimiters */
+    bool isDelimiter_[256];
+
+    /** @return the end of the line starting at p (the new line character or last) */
+    static char const* endOfLine(char const* p, char const* last)
+    {
+      char const* q = static_cast<char const*>(std::memchr(p, '\n', last - p));
+      return q ? q : last;
+    }
+    /** @return @c true if c is a blank character */
+    static bool isBlank(char c) { return c == ' ' || c == '\t' || c == '\r';}
+    /** @return @c true if the line [first, last) contains only blank characters */
+    static bool isBlankLine(char const* first, char const* last)
+    {
+      for (; first != last; ++first) { if (!isBlank(*first)) return false;}
+      return true;
+    }
+    /** remove the blanks and the quotes around the field [first, last) */
+    static void trim(char const*& first, char const*& last)
+    {
+      while (first != last && isBlank(*first)) ++first;
+      while (first != last && isBlank(*(last-1))) --last;
+      if (last - first >= 2 && *first == '"' && *(last-1) == '"') { ++first; --last;}
+    }
+    /** count the rows and the maximal number of fields in [first, last) */
+    void countRows(char const* first, char const* last, int& nbRow, int& nbField) const;
+    /** parse the rows in [first, last) and store them starting at row @c row
+     *  @return the number of numbers out of the range of Type
+     **/
+    int parseRows(char const* first, char const* last, int row);
+};
+
+template<class Array>
+bool ReadCsvToArray<Array>::run()
+{
+  try
+  {
+    if (p_data_) { delete p_data_; p_data_ = 0;}
+    names_.clear();
+    nbOutOfRange_ = 0;
+    hidden::CsvFileBuffer file;
+    if (!file.open(file_name_))
+    {
+      msg_error_ = Csv::ERRORCODES[4];
+      msg_error_ += "\nFile: " + file_name_;
+      return false;
+    }
+    for (int c = 0; c < 256; ++c) { isDelimiter_[c] = false;}
+    for (String::const_iterator it = delimiters_.begin(); it != delimiters_.end(); ++it)
+    { isDelimiter_[(unsigned char)*it] = true;}
+    char const* first = file.begin(), *last = file.end();
+    // read the names in the first non blank line
+    if (withNames_)
+    {
+      char const* eol = endOfLine(first, last);
+      while (first != last && isBlankLine(first, eol))
+      { first = (eol == last) ? last : eol + 1; eol = endOfLine(first, last);}
+      char const* fieldBegin = first;
+      for (char const* p = first; ; ++p)
+      {
+        if (p == eol || isDelimiter_[(unsigned char)*p])
+        {
+          char const* b = fieldBegin, *e = p;
+          trim(b, e);
+          names_.push_back(String(b, e));
+          if (p == eol) break;
+          fieldBegin = p+1;
+        }
+      }
+      first = (eol == last) ? last : eol + 1;
+    }
+    // split the file in chunks of complete lines
+    int nbChunk = 1;
+#ifdef _OPENMP
+    nbChunk = 4*omp_get_max_threads();
+#endif
+    nbChunk = std::max(1, std::min<int>(nbChunk, (last - first) / (1<<16)));
+    std::vector<char const*> bounds(nbChunk+1);
+    bounds[0] = first; bounds[nbChunk] = last;
+    for (int k = 1; k < nbChunk; ++k)
+    {
+      char const* p = std::max(bounds[k-1], first + (last - first)/nbChunk * k);
+      p = endOfLine(p, last);
+      bounds[k] = (p == last) ? last : p + 1;
+    }
+    // first pass: count the rows and the fields of each chunk
+    std::vector<int> nbRows(nbChunk+1, 0), nbFields(nbChunk, 0);
+#ifdef _OPENMP
+#pragma omp parallel for schedule(dynamic)
+#endif
+    for (int k = 0; k < nbChunk; ++k)
+    { countRows(bounds[k], bounds[k+1], nbRows[k+1], nbFields[k]);}
+    int nbVar = names_.size();
+    for (int k = 0; k < nbChunk; ++k)
+    { nbRows[k+1] += nbRows[k]; nbVar = std::max(nbVar, nbFields[k]);}
+    // second pass: parse the fields
+    p_data_ = new Array(nbRows[nbChunk], nbVar);
+    std::vector<int> nbOut(nbChunk, 0);
+#ifdef _OPENMP
+#pragma omp parallel for schedule(dynamic)
+#endif
+    for (int k = 0; k < nbChunk; ++k)
+    { nbOut[k] = parseRows(bounds[k], bounds[k+1], p_data_->beginRows() + nbRows[k]);}
+    for (int k = 0; k < nbChunk; ++k) { nbOutOfRange_ += nbOut[k];}
+    this->hasRun_ = true;
+    return true;
+  }
+  catch(Exception const& e) { msg_error_ = e.error();}
+  catch(...) { msg_error_ = Csv::ERRORCODES[1];}
+  return false;
+}
+
+template<class Array>
+void ReadCsvToArray<Array>::countRows(char const* first, char const* last, int& nbRow, int& nbField) const
+{
+  nbRow = 0; nbField = 0;
+  while (first != last)
+  {
+    char const* eol = endOfLine(first, last);
+    if (!isBlankLine(first, eol))
+    {
+      int n = 1;
+      for (char const* p = first; p != eol; ++p) { if (isDelimiter_[(unsigned char)*p]) ++n;}
+      nbField = std::max(nbField, n);
+      ++nbRow;
+    }
+    first = (eol == last) ? last : eol + 1;
+  }
+}
+
+template<class Array>
+int ReadCsvToArray<Array>::parseRows(char const* first, char const* last, int row)
+{
+  Array& data = *p_data_;
+  int nbOut = 0;
+  bool outOfRange;
+  while (first != last)
+  {
+    char const* eol = endOfLine(first, last);
+    if (!isBlankLine(first, eol))
+    {
+      int col = data.beginCols();
+      char const* fieldBegin = first;
+      for (char const* p = first; ; ++p)
+      {
+        if (p == eol || isDelimiter_[(unsigned char)*p])
+        {
+          char const* b = fieldBegin, *e = p;
+          trim(b, e);
+          data.elt(row, col++) = hidden::CsvParserImpl<Type>::run(b, e, outOfRange);
+          if (outOfRange) ++nbOut;
+          if (p == eol) break;
+          fieldBegin = p+1;
+        }
+      }
+      // Append NA values if the row is not complete
+      for (; col < data.endCols(); ++col) { data.elt(row, col) = Arithmetic<Type>::NA();}
+      ++row;
+    }
+    first = (eol == last) ? last : eol + 1;
+  }
+  return nbOut;
+}
+
+} // namespace STK
+
+#endif /* STK_READCSVTOARRAY_H */
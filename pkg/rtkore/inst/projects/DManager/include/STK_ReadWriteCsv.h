@@ -40,6 +40,7 @@
 
 #include <iomanip>
 #include <Arrays/include/STK_Array1D.h>
+#include <Arrays/include/STK_Array2D.h>
 #include <Arrays/include/STK_ArrayBase.h>
 #include "STK_Variable.h"
 
@@ -47,6 +48,7 @@ namespace STK
 {
 
 template<typename Type> class TReadWriteCsv;
+template<class Array> class ReadCsvToArray;
 
 typedef class TReadWriteCsv<String> ReadWriteCsv;
 
@@ -462,38 +464,13 @@ class TReadWriteCsv
     inline bool read(std::map<String, Type> const& mapping)
     { return read(file_name_);}
     /** Reads the specified file with the specified read flags.
+     *  The files of @c Real or @c int values are read without stream by
+     *  ReadCsvToArray if no mapping is set.
      *  @param file_name name of the file to read
      *  @return  @c true if successful, @c false if an error is encountered.
      **/
-    bool read(std::string const& file_name)
-    {
-      try
-      {
-        // update current file_name
-        file_name_ = file_name;
-        // input file stream
-        ifstream inFile;
-        // open file
-        inFile.open(file_name.c_str(),std::ios::in);
-        // check error
-        if (inFile.rdstate() & std::ios::failbit)
-        {
-          inFile.close();
-          msg_error_ = Csv::ERRORCODES[4];
-          msg_error_ += "\nFile: " + file_name;
-          return false;
-        }
-        read(inFile);                  // and read it
-        inFile.close();
-        // return
-        return true;
-      }
-      catch(const Exception& e)
-      { msg_error_ = e.error();}
-      catch(...)
-      { msg_error_ = Csv::ERRORCODES[1];}
-      return false;
-    }
+    inline bool read(std::string const& file_name)
+    { return readFile(file_name, (Type*)0);}
     /** Reads the specified input stream with the specified read flags.
      *  @param inBuffer name of the stream to read
      *  @return  @c true if successful, @c false if an error is encountered.
@@ -681,6 +658,83 @@ class TReadWriteCsv
       nbVars_ = std::max(nbVars_, nbField);
       inBuffer.seekg(pos);
     }
+    /** Reads a file of @c Real values.
+     *  @param file_name name of the file to read
+     **/
+    inline bool readFile(std::string const& file_name, Real*)
+    { return with_mapping_ ? readStream(file_name) : readArray(file_name);}
+    /** Reads a file of @c int values.
+     *  @param file_name name of the file to read
+     **/
+    inline bool readFile(std::string const& file_name, int*)
+    { return with_mapping_ ? readStream(file_name) : readArray(file_name);}
+    /** Reads a file of any other type.
+     *  @param file_name name of the file to read
+     **/
+    template<typename Other>
+    inline bool readFile(std::string const& file_name, Other*)
+    { return readStream(file_name);}
+    /** Reads the specified file using a stream.
+     *  @param file_name name of the file to read
+     *  @return  @c true if successful, @c false if an error is encountered.
+     **/
+    bool readStream(std::string const& file_name)
+    {
+      try
+      {
+        // update current file_name
+        file_name_ = file_name;
+        // input file stream
+        ifstream inFile;
+        // open file
+        inFile.open(file_name.c_str(),std::ios::in);
+        // check error
+        if (inFile.rdstate() & std::ios::failbit)
+        {
+          inFile.close();
+          msg_error_ = Csv::ERRORCODES[4];
+          msg_error_ += "\nFile: " + file_name;
+          return false;
+        }
+        read(inFile);                  // and read it
+        inFile.close();
+        // return
+        return true;
+      }
+      catch(const Exception& e)
+      { msg_error_ = e.error();}
+      catch(...)
+      { msg_error_ = Csv::ERRORCODES[1];}
+      return false;
+    }
+    /** Reads the specified file of numeric values using ReadCsvToArray.
+     *  @param file_name name of the file to read
+     *  @return  @c true if successful, @c false if an error is encountered.
+     **/
+    bool readArray(std::string const& file_name)
+    {
+      file_name_ = file_name;
+      ReadCsvToArray< Array2D<Type> > reader(file_name, delimiters_, with_names_);
+      if (!reader.run())
+      {
+        msg_error_ = reader.error();
+        return false;
+      }
+      Array2D<Type> const& data = *reader.p_data();
+      std::vector<String> const& names = reader.names();
+      nbVars_ = data.sizeCols();
+      nbRows_ = data.sizeRows();
+      str_data_.clear();
+      resizeCols(nbVars_);
+      resizeRows(nbRows_);
+      for (int j = data.beginCols(), icol = begin(); j < data.endCols(); ++j, ++icol)
+      {
+        if (j - data.beginCols() < (int)names.size()) { setName(icol, names[j - data.beginCols()]);}
+        for (int i = data.beginRows(), irow = str_data_.elt(icol).begin(); i < data.endRows(); ++i, ++irow)
+        { fastSetData(icol, irow, data.elt(i, j));}
+      }
+      return true;
+    }
     /** Set without check the specified value to the element (icol, irow).
      *  @param icol index of the column
      *  @param irow index of the row
@@ -821,4 +875,7 @@ void TReadWriteCsv<Type>::writeSelection( ostream& os, int top, int bottom, int
 
 } // namespace STK
 
+// TReadWriteCsv<Real> and TReadWriteCsv<int> read the files with ReadCsvToArray
+#include "STK_ReadCsvToArray.h"
+
 #endif // STK_READWRITECSV_H
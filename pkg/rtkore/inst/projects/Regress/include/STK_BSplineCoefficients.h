@@ -38,8 +38,12 @@
 
 #include "STK_IBasis.h"
 
+#include <vector>
+
 #include <Arrays/include/STK_Array2DVector.h>
+#include <Arrays/include/STK_CArray.h>
 #include <DManager/include/STK_HeapSort.h>
+#include <Algebra/include/STK_NormalEquations.h>
 
 #ifdef STK_REGRESS_VERBOSE
 #include <Arrays/include/STK_Display.h>
@@ -57,6 +61,14 @@ namespace STK
  *
  * @note If the input data set is a vector of size @c n the output matrix of the
  * coefficients @c Coefficients() is a matrix of size @c (n, nbControlPoints).
+ *
+ * Each row of the coefficients has at most @c degree+1 non-zero values. They
+ * are also stored in a banded form: @c firstIndexes()[i] is the first
+ * non-zero column of the row @c i and @c bandCoefficients().row(i) contains
+ * the @c degree+1 values. If the dense storage is disabled
+ * (setDenseStorage(false)) only the banded form is computed and the products
+ * needed by a least square regression are available using bandedCrossProduct,
+ * bandedMultLeftTranspose and bandedMult.
  */
 template<class Data>
 class BSplineCoefficients: public IBasis<Data, ArrayXX>
@@ -122,6 +134,13 @@ class BSplineCoefficients: public IBasis<Data, ArrayXX>
     inline int nbControlPoints() const { return dim_;}
     /** @return the vector of knots of the B-spline curve */
     inline VectorX const& knots() const { return knots_;}
+    /** @return @c true if the dense matrix of the coefficients is computed */
+    inline bool isDenseStorage() const { return isDenseStorage_;}
+    /** @return the first non-zero column of each row of the coefficients */
+    inline VectorXi const& firstIndexes() const { return firstIndexes_;}
+    /** @return the degree+1 values of each row of the coefficients starting
+     *  at the column firstIndexes() */
+    inline CArrayByRowXX const& bandCoefficients() const { return bandCoefficients_;}
     // setters
     /** Set the number of control point (the number of BSpline)
      *  @param nbControlPoints number of control points
@@ -131,6 +150,11 @@ class BSplineCoefficients: public IBasis<Data, ArrayXX>
      *  @param dim number of control points
      **/
     inline void setDim( int dim) { setNbControlPoints(dim);}
+    /** Enable or disable the computation of the dense matrix of the coefficients.
+     *  @param isDenseStorage @c false if only the banded form is needed
+     **/
+    inline void setDenseStorage( bool isDenseStorage)
+    { isDenseStorage_ = isDenseStorage; Base::update();}
     /** Set the degree of the BSpline basis
      *  @param degree degree of the B-spline curves (default is 3)
      **/
@@ -169,6 +193,33 @@ class BSplineCoefficients: public IBasis<Data, ArrayXX>
     template<class OtherVector>
     ArrayXX extrapolate(OtherVector const& x) const;
 
+    /** @return the product \f$ X'WX \f$ of the coefficients stored by
+     *  diagonals (see bandCholesky): the element (j, d) is \f$ (X'WX)_{j,j-d} \f$.
+     *  @param weights the weights of the samples
+     **/
+    template<class Weights>
+    CArrayByRowXX bandedCrossProduct(Weights const& weights) const;
+    /** @return the product \f$ X'X \f$ of the coefficients stored by diagonals */
+    inline CArrayByRowXX bandedCrossProduct() const
+    { return bandedCrossProduct(hidden::UnitWeights());}
+    /** @return the product \f$ X'WY \f$ of the coefficients with y
+     *  @param y the values to multiply
+     *  @param weights the weights of the samples
+     **/
+    template<class YArray, class Weights>
+    ArrayXX bandedMultLeftTranspose(YArray const& y, Weights const& weights) const;
+    /** @return the product \f$ X'Y \f$ of the coefficients with y
+     *  @param y the values to multiply
+     **/
+    template<class YArray>
+    inline ArrayXX bandedMultLeftTranspose(YArray const& y) const
+    { return bandedMultLeftTranspose(y, hidden::UnitWeights());}
+    /** @return the product \f$ X\beta \f$ of the coefficients with beta
+     *  @param beta the values to multiply
+     **/
+    template<class Array>
+    Array bandedMult(Array const& beta) const;
+
   protected:
     /** degree of the B-splines curves. */
     int degree_;
@@ -182,6 +233,12 @@ class BSplineCoefficients: public IBasis<Data, ArrayXX>
     int lastControlPoint_;
     /** Data of the knots */
     VectorX knots_;
+    /** @c true if the dense matrix of the coefficients is computed */
+    bool isDenseStorage_;
+    /** first non-zero column of each row of the coefficients */
+    VectorXi firstIndexes_;
+    /** non-zero values of each row of the coefficients */
+    CArrayByRowXX bandCoefficients_;
 
     /** compute the position of the knots of the B-spline curves.*/
     bool computeKnots();
@@ -197,11 +254,12 @@ class BSplineCoefficients: public IBasis<Data, ArrayXX>
      *  @param isSorted @c true if the data is sorted, @c false otherwise
      **/
     void computeDensityKnots(bool isSorted);
-    /** Compute a row of the coefficients matrix for a given value.
-     * @param irow index of the row
-     * @param value the value to which we want to compute the row
+    /** Compute the non-zero values of the basis for a given value.
+     * @param value the value to which we want to compute the basis
+     * @param p_band array of size degree_+1 receiving the values
+     * @return the index of the first non-zero value
      **/
-    void computeCoefficientsRow(int irow, Real const& value);
+    int computeBasis(Real const& value, Real* p_band) const;
 };
 
 /* constructor */
@@ -218,6 +276,9 @@ BSplineCoefficients<Data>::BSplineCoefficients( Data const* p_data
                                                 , nbKnots_(nbControlPoints + degree + 1)
                                                 , lastControlPoint_(dim_-1)
                                                 , knots_( Range(0, nbKnots_) )
+                                                , isDenseStorage_(true)
+                                                , firstIndexes_()
+                                                , bandCoefficients_()
 { }
 
 /* constructor */
@@ -234,6 +295,9 @@ BSplineCoefficients<Data>::BSplineCoefficients( Data const& data
                                               , nbKnots_(nbControlPoints + degree +1)
                                               , lastControlPoint_(dim_-1)
                                               , knots_( Range(0, nbKnots_) )
+                                              , isDenseStorage_(true)
+                                              , firstIndexes_()
+                                              , bandCoefficients_()
 {}
 /* copy constructor.
  *  @param coefs the coefficients to copy
@@ -246,6 +310,9 @@ BSplineCoefficients<Data>::BSplineCoefficients( BSplineCoefficients const& coefs
                                               , nbKnots_(coefs.nbKnots_)
                                               , lastControlPoint_(coefs.lastControlPoint_)
                                               , knots_(coefs.knots_)
+                                              , isDenseStorage_(coefs.isDenseStorage_)
+                                              , firstIndexes_(coefs.firstIndexes_)
+                                              , bandCoefficients_(coefs.bandCoefficients_)
 {}
 
 
@@ -336,7 +403,13 @@ bool BSplineCoefficients<Data>::run()
    msg_error_ = STKERROR_NO_ARG(Error in BSplineCoefficients::run,p_data_ is null);
    return false;
   }
-  if (!this->initializeStep()) return false;
+  if (isDenseStorage_)
+  { if (!this->initializeStep()) return false;}
+  else
+  {
+    coefficients_.clear();
+    if (!this->initializeValues()) return false;
+  }
   knots_ = minValue_;
   // compute the knots and coefficients
   if (computeKnots()) { computeCoefficients();}
@@ -361,42 +434,11 @@ ArrayXX BSplineCoefficients<Data>::extrapolate(OtherVector const& x) const
   // check if the original data set was not reduced to a single point
   if (minValue_ == maxValue_) return coefs;
   // compute the coefficients
+  std::vector<Real> band(degree_+1);
   for (int irow=x.begin(); irow< x.end(); irow++)
   {
-    const Real value = x[irow];
-    // value outside the range of the knots case
-    if (value <= minValue_)
-    {
-      coefs(irow, 0) = 1.0;
-      continue;
-    }
-    if (value >= maxValue_)
-    {
-      coefs(irow, lastControlPoint_) = 1.0;
-      continue;
-    }
-    // find interval
-    int k, k1;
-    for (k=0, k1=1; k<lastControlPoint_; k++, k1++)
-    {
-      if (value < knots_[k1]) break;
-    }
-    // begin recursion
-    coefs(irow, k) = 1.0;
-    for (int d=1; d<=degree_; d++)
-    {
-      // right (south-west corner) term only
-      coefs(irow, k-d) = ( (knots_[k1] - value)/(knots_[k1] - knots_[k1-d]) ) * coefs(irow, k1-d);
-      // compute internal terms
-      for (int i = k1-d; i<k; i++)
-      {
-        const Real knots_i = knots_[i], knots_id1 = knots_[i+d+1];
-        coefs(irow, i) = ( (value - knots_i)/(knots_[i+d] - knots_i) ) * coefs(irow, i)
-                       + ( (knots_id1 - value)/(knots_id1 - knots_[i+1]) ) * coefs(irow, i+1);
-      }
-      // left (north-west corner) term only
-      coefs(irow, k) *= (value - knots_[k])/(knots_[k+d] - knots_[k]);
-    }
+    int first = computeBasis(x[irow], band.data());
+    for (int d=0; d<=degree_; d++) { coefs(irow, first+d) = band[d];}
   }
   return coefs;
 }
@@ -420,7 +462,7 @@ bool BSplineCoefficients<Data>::computeKnots()
       break;
     // density position
     case Regress::densityKnotsPositions_:
-      computeDensityKnots(true);
+      computeDensityKnots(false);
       break;
     default:
 
@@ -445,9 +487,26 @@ void BSplineCoefficients<Data>::computeCoefficients()
   stk_cout << _T("BSplineCoefficients::computeCoefficients()\n");
 #endif
 
+  firstIndexes_.resize(p_data_->range());
+  bandCoefficients_.resize(p_data_->range(), Range(0, degree_+1));
   // compute the coefficients
-  for (int i=p_data_->begin(); i< p_data_->end(); i++)
-  { computeCoefficientsRow(i, (*p_data_)[i]);}
+#ifdef _OPENMP
+#pragma omp parallel
+#endif
+  {
+    std::vector<Real> band(degree_+1);
+#ifdef _OPENMP
+#pragma omp for schedule(static)
+#endif
+    for (int i=p_data_->begin(); i< p_data_->end(); i++)
+    {
+      int first = computeBasis((*p_data_)[i], band.data());
+      firstIndexes_[i] = first;
+      for (int d=0; d<=degree_; d++) { bandCoefficients_(i, d) = band[d];}
+      if (isDenseStorage_)
+      { for (int d=0; d<=degree_; d++) { coefficients_(i, first+d) = band[d];}}
+    }
+  }
 
 #ifdef STK_REGRESS_VERBOSE
   stk_cout << _T("BSplineCoefficients::computeCoefficients() done\n");
@@ -485,8 +544,8 @@ void BSplineCoefficients<Data>::computePeriodicKnots()
 template<class Data>
 void BSplineCoefficients<Data>::computeDensityKnots(bool isSorted)
 {
-  // sorted data
-  Data xtri(*p_data_, true);
+  // sorted data, copy the data if they have to be sorted
+  Data xtri(*p_data_, isSorted);
   // sort the data
   if (!isSorted) heapSort< Data >(xtri);
 
@@ -508,48 +567,146 @@ void BSplineCoefficients<Data>::computeDensityKnots(bool isSorted)
   }
 }
 
-/* Compute a row of the coefficients
- * @param irow index of the row
- **/
+/* Compute the non-zero values of the basis for a given value. */
 template<class Data>
-void BSplineCoefficients<Data>::computeCoefficientsRow(int irow, Real const& value)
+int BSplineCoefficients<Data>::computeBasis(Real const& value, Real* p_band) const
 {
+  for (int d=0; d<=degree_; d++) { p_band[d] = 0.0;}
   // value outside the range of the knots case
   if (value <= minValue_)
   {
-    coefficients_(irow, 0) = 1.0;
-    return;
+    p_band[0] = 1.0;
+    return 0;
   }
   if (value >= maxValue_)
   {
-    coefficients_(irow, lastControlPoint_) = 1.0;
-    return;
+    p_band[degree_] = 1.0;
+    return lastControlPoint_ - degree_;
   }
-  // find interval
-  int k, k1;
-  for (k=0, k1=1; k<lastControlPoint_; k++, k1++)
+  // find interval: k is the last index such that knots_[k] <= value < knots_[k+1]
+  int k = 0, k1 = lastControlPoint_;
+  while (k < k1)
   {
-    if (value < knots_[k1]) break;
+    int mid = (k + k1)/2;
+    if (value < knots_[mid+1]) { k1 = mid;} else { k = mid+1;}
   }
-  // begin recursion
-  coefficients_(irow, k) = 1.0;
+  // the knots are sorted if the data are, keep the first non-zero column in
+  // [0, dim_-degree_-1] otherwise
+  k = std::min(std::max(k, degree_), lastControlPoint_);
+  k1 = k+1;
+  // begin recursion, the column c is stored in p_band[c-first]
+  const int first = k - degree_;
+  p_band[degree_] = 1.0;
   for (int d=1; d<=degree_; d++)
   {
     // right (south-west corner) term only
-    coefficients_(irow, k-d) = ( (knots_[k1] - value)/(knots_[k1] - knots_[k1-d]) )
-                               * coefficients_(irow, k1-d);
+    p_band[k-d-first] = ( (knots_[k1] - value)/(knots_[k1] - knots_[k1-d]) )
+                        * p_band[k1-d-first];
     // compute internal terms
     for (int i = k1-d; i<k; i++)
     {
       const Real knots_i = knots_[i], knots_id1 = knots_[i+d+1];
-      coefficients_(irow, i) = ( (value - knots_i)/(knots_[i+d] - knots_i) )
-                               * coefficients_(irow, i)
-                             + ( (knots_id1 - value)/(knots_id1 - knots_[i+1]) )
-                               * coefficients_(irow, i+1);
+      p_band[i-first] = ( (value - knots_i)/(knots_[i+d] - knots_i) ) * p_band[i-first]
+                      + ( (knots_id1 - value)/(knots_id1 - knots_[i+1]) ) * p_band[i+1-first];
     }
     // left (north-west corner) term only
-    coefficients_(irow, k) *= (value - knots_[k])/(knots_[k+d] - knots_[k]);
+    p_band[degree_] *= (value - knots_[k])/(knots_[k+d] - knots_[k]);
+  }
+  return first;
+}
+
+/* compute X'WX using the banded coefficients */
+template<class Data>
+template<class Weights>
+CArrayByRowXX BSplineCoefficients<Data>::bandedCrossProduct(Weights const& weights) const
+{
+  // split the rows in nbBlock blocks summed in a fixed order
+  Range rows = firstIndexes_.range();
+  const int nbBlock = std::max(1, std::min(int(NormalEquations::maxChunk_)
+                                          , (rows.size() + NormalEquations::blockSize_ - 1)/NormalEquations::blockSize_));
+  const int size = (rows.size() + nbBlock - 1)/nbBlock;
+  Array1D<CArrayByRowXX> prods(nbBlock);
+#ifdef _OPENMP
+#pragma omp parallel for schedule(static)
+#endif
+  for (int b = 0; b < nbBlock; ++b)
+  {
+    CArrayByRowXX& prod = prods[prods.begin() + b];
+    prod.resize(Range(0, dim_), Range(0, degree_+1)) = 0.;
+    const int end = std::min(rows.begin() + (b+1) * size, rows.end());
+    for (int i = rows.begin() + b * size; i < end; ++i)
+    {
+      const int first = firstIndexes_[i];
+      const Real w = weights[i];
+      for (int a=0; a<=degree_; a++)
+      {
+        const Real wa = w * bandCoefficients_(i, a);
+        for (int c=0; c<=a; c++) { prod(first+a, a-c) += wa * bandCoefficients_(i, c);}
+      }
+    }
+  }
+  CArrayByRowXX res(Range(0, dim_), Range(0, degree_+1), 0.);
+  for (int b = prods.begin(); b < prods.end(); ++b) { res += prods[b];}
+  return res;
+}
+
+/* compute X'WY using the banded coefficients */
+template<class Data>
+template<class YArray, class Weights>
+ArrayXX BSplineCoefficients<Data>::bandedMultLeftTranspose(YArray const& y, Weights const& weights) const
+{
+  if (y.rows() != firstIndexes_.range())
+  { STKRUNTIME_ERROR_NO_ARG(BSplineCoefficients::bandedMultLeftTranspose,y.rows() != coefficients rows);}
+  // split the rows in nbBlock blocks summed in a fixed order
+  Range rows = firstIndexes_.range();
+  const int nbBlock = std::max(1, std::min(int(NormalEquations::maxChunk_)
+                                          , (rows.size() + NormalEquations::blockSize_ - 1)/NormalEquations::blockSize_));
+  const int size = (rows.size() + nbBlock - 1)/nbBlock;
+  Array1D<ArrayXX> prods(nbBlock);
+#ifdef _OPENMP
+#pragma omp parallel for schedule(static)
+#endif
+  for (int b = 0; b < nbBlock; ++b)
+  {
+    ArrayXX& prod = prods[prods.begin() + b];
+    prod.resize(Range(0, dim_), y.cols()) = 0.;
+    const int end = std::min(rows.begin() + (b+1) * size, rows.end());
+    for (int i = rows.begin() + b * size; i < end; ++i)
+    {
+      const int first = firstIndexes_[i];
+      const Real w = weights[i];
+      for (int a=0; a<=degree_; a++)
+      {
+        const Real wa = w * bandCoefficients_(i, a);
+        for (int l=y.beginCols(); l<y.endCols(); l++) { prod(first+a, l) += wa * y(i, l);}
+      }
+    }
+  }
+  ArrayXX res(Range(0, dim_), y.cols(), 0.);
+  for (int b = prods.begin(); b < prods.end(); ++b) { res += prods[b];}
+  return res;
+}
+
+/* compute X beta using the banded coefficients */
+template<class Data>
+template<class Array>
+Array BSplineCoefficients<Data>::bandedMult(Array const& beta) const
+{
+  Array res(firstIndexes_.range(), beta.cols());
+#ifdef _OPENMP
+#pragma omp parallel for schedule(static)
+#endif
+  for (int i=firstIndexes_.begin(); i<firstIndexes_.end(); i++)
+  {
+    const int first = firstIndexes_[i] + beta.beginRows();
+    for (int l=beta.beginCols(); l<beta.endCols(); l++)
+    {
+      Real sum = 0.;
+      for (int a=0; a<=degree_; a++) { sum += bandCoefficients_(i, a) * beta(first+a, l);}
+      res(i, l) = sum;
+    }
   }
+  return res;
 }
 
 } // namespace STK
@@ -39,13 +39,18 @@
 #include "STK_BSplineCoefficients.h"
 #include "STK_IRegression.h"
 
-#include <Algebra/include/STK_InvertMatrix.h>
+#include <Algebra/include/STK_SymEigen.h>
+#include <Algebra/include/STK_Cholesky.h>
 
 namespace STK
 {
 
 /** @brief Compute a BSpline, multi-valued, regression function using BSpline
  *  basis.
+ *
+ *  The coefficients of the BSpline basis are only stored in banded form (see
+ *  BSplineCoefficients) and the normal equations, whose matrix is a band
+ *  matrix, are solved using bandCholesky.
  */
 template <class YArray, class XVector, class Weights = VectorX>
 class BSplineRegression: public IRegression<YArray, XVector, Weights>
@@ -80,8 +85,14 @@ class BSplineRegression: public IRegression<YArray, XVector, Weights>
     inline YArray const& controlPoints() const { return controlPoints_; }
     /**  @return the knots of the B-spline curve */
     inline VectorX const& knots() const { return coefs_.knots(); }
-    /** @return the coefficients of the B-spline curve */
-    inline YArray const& coefficients() const { return coefs_.coefficients();}
+    /** @return the (dense) coefficients of the B-spline curve. They are
+     *  computed from the banded coefficients at the first call.
+     **/
+    inline ArrayXX const& coefficients() const
+    {
+      if (denseCoefs_.empty()) { denseCoefs_ = coefs_.extrapolate(*p_x_);}
+      return denseCoefs_;
+    }
     /** @return the Extrapolates values of y from the value @c x.
      *  Given the data set @c x will compute the values \f$ y = \psi(x) \hat{\beta} \f$
      *  where \f$ \psi \f$ represents the B-spline basis functions and \f$ \hat{beta} \f$
@@ -101,6 +112,8 @@ class BSplineRegression: public IRegression<YArray, XVector, Weights>
     BSplineCoefficients<XVector> coefs_;
     /** Estimated control points of the B-spline curve */
     YArray controlPoints_;
+    /** dense coefficients, computed on demand by coefficients() */
+    mutable ArrayXX denseCoefs_;
     /** Compute the coefficients of the BSpline basis. This method is triggered
      *  by the base class @c IRegression::run()
      **/
@@ -118,6 +131,10 @@ class BSplineRegression: public IRegression<YArray, XVector, Weights>
      *  is triggered by the base class @c IRegression::run() after initializeStep()
      **/
     virtual bool predictionStep();
+    /** Solve the normal equations. On entry controlPoints_ contains X'WY.
+     *  @param prod the matrix X'WX stored by diagonals
+     **/
+    bool solve(CArrayByRowXX const& prod);
     /** Compute the number of parameter of the regression function.
      * @return the number of parameter of the regression function
      **/
@@ -138,7 +155,8 @@ BSplineRegression<YArray, XVector, Weights>::BSplineRegression( YArray const* p_
                                                               , position_(position)
                                                               , coefs_(*p_x, nbControlPoints_, degree_, position_)
                                                               , controlPoints_()
-{ }
+                                                              , denseCoefs_()
+{ coefs_.setDenseStorage(false);}
 
 template <class YArray, class XVector, class Weights>
 BSplineRegression<YArray, XVector, Weights>::~BSplineRegression()
@@ -146,34 +164,55 @@ BSplineRegression<YArray, XVector, Weights>::~BSplineRegression()
 
 template <class YArray, class XVector, class Weights>
 bool BSplineRegression<YArray, XVector, Weights>::initializeStep()
-{ return coefs_.run();}
+{
+  denseCoefs_.clear();
+  return coefs_.run();
+}
 /* compute the regression function. */
 template <class YArray, class XVector, class Weights>
 bool BSplineRegression<YArray, XVector, Weights>::regressionStep()
 {
-  // compute X'X
-  ArraySquareX prod = coefs_.coefficients().transpose() * coefs_.coefficients();
-  // compute (X'X)^{-1}
-//  GInvertSymMatrix<ArraySquareX> inv;
-//  inv(prod);
-
-  // compute (X'X)^{-1}X'Y
-  controlPoints_ = invert(prod.symmetrize()) * (coefs_.coefficients().transpose() * p_y_->asDerived());
-  return true;
+  // compute X'X and X'Y
+  CArrayByRowXX prod = coefs_.bandedCrossProduct();
+  controlPoints_ = coefs_.bandedMultLeftTranspose(p_y_->asDerived());
+  // solve X'X beta = X'Y
+  return solve(prod);
 }
 
 /* compute the regression function. */
 template <class YArray, class XVector, class Weights>
 bool BSplineRegression<YArray, XVector, Weights>::regressionStep(Weights const& weights)
 {
-  // compute X'X
-  ArraySquareX prod = coefs_.coefficients().transpose() * weights.diagonalize() * coefs_.coefficients();
-  // compute (X'X)^{-1}
-  // GInvertSymMatrix<ArraySquareX> inv;
-  // inv(prod);
-  // compute (X'X)^{-1}X'Y
-  controlPoints_ = invert(prod.symmetrize()) * coefs_.coefficients().transpose() * weights.diagonalize() * p_y_->asDerived();
-  //controlPoints_ = prod * coefs_.coefficients().transpose() * weights.diagonalize() * p_y_->asDerived();
+  // compute X'WX and X'WY
+  CArrayByRowXX prod = coefs_.bandedCrossProduct(weights);
+  controlPoints_ = coefs_.bandedMultLeftTranspose(p_y_->asDerived(), weights);
+  // solve X'WX beta = X'WY
+  return solve(prod);
+}
+
+/* solve the normal equations */
+template <class YArray, class XVector, class Weights>
+bool BSplineRegression<YArray, XVector, Weights>::solve(CArrayByRowXX const& prod)
+{
+  CArrayByRowXX decomp = prod;
+  if (bandCholesky(decomp))
+  {
+    bandCholeskySolve(decomp, controlPoints_);
+    return true;
+  }
+  // X'X is singular (a B-spline without data): use a generalized inverse
+  ArraySquareX dense(prod.rows(), 0.);
+  for (int j=prod.beginRows(); j<prod.endRows(); j++)
+  {
+    for (int d=0; d<=std::min(degree_, j-prod.beginRows()); d++)
+    { dense(j, j-d) = dense(j-d, j) = prod(j, prod.beginCols()+d);}
+  }
+  SymEigen<ArraySquareX> eigen(dense);
+  eigen.run();
+  ArraySquareX ginv;
+  eigen.ginv(ginv);
+  YArray xty = controlPoints_;
+  controlPoints_ = ginv * xty;
   return true;
 }
 
@@ -181,7 +220,7 @@ bool BSplineRegression<YArray, XVector, Weights>::regressionStep(Weights const&
 template <class YArray, class XVector, class Weights>
 bool BSplineRegression<YArray, XVector, Weights>::predictionStep()
 {
-  predicted_ = coefs_.coefficients() * controlPoints_;
+  predicted_ = coefs_.bandedMult(controlPoints_);
   return true;
 }
 
@@ -100,6 +100,9 @@ class IBasis: public IRunnerBase
 
     /** Initialize the parameters minValue_ and maxValue_ using data set */
     bool initializeStep();
+    /** Initialize the parameters minValue_ and maxValue_ using data set
+     *  without allocating the matrix of the coefficients */
+    bool initializeValues();
 
   protected:
     /** update IBasis
@@ -182,6 +185,12 @@ bool IBasis<Data, Coefs>::initializeStep()
 {
   // resize and initialize coeficients
   coefficients_.resize(p_data_->range(), Range(0, dim_)) =0;
+  return initializeValues();
+}
+/* Initialize the parameters minValue_ and maxValue_ */
+template<class Data, class Coefs>
+bool IBasis<Data, Coefs>::initializeValues()
+{
   // compute min and max value
   if (useDataValues_)
   {
@@ -38,7 +38,8 @@
 #define STK_MULTIDIMREGRESSION_H
 
 #include <Arrays/include/STK_Array2D.h> // for coefs
-#include <Algebra/include/STK_InvertMatrix.h>
+#include <Algebra/include/STK_SymEigen.h>
+#include <Algebra/include/STK_NormalEquations.h>
 #include "STK_IRegression.h"
 
 namespace STK
@@ -68,9 +69,21 @@ class MultidimRegression: public IRegression<Array, Array, Weight>
      *  @param x the input data set
      */
     virtual Array extrapolate(Array const& x) const;
+    /** compute the coefficients of the regression from normal equations
+     *  accumulated by the caller, e.g. by chunks of rows which are never all
+     *  in memory. The predicted values and the residuals are not computed.
+     *  @param eq the normal equations \f$ X'WX\beta = X'WY \f$
+     *  @return @c false if no sample has been accumulated, @c true otherwise
+     **/
+    bool run(NormalEquations const& eq);
+    using Base::run;
 
   protected:
     ArrayXX coefs_;
+    /** solve the normal equations, use a generalized inverse if X'WX is singular
+     *  @param eq the normal equations
+     **/
+    void solve(NormalEquations const& eq);
 
   private:
     /** compute the regression function. */
@@ -98,14 +111,10 @@ MultidimRegression<Array,Weight>::MultidimRegression( Array const* y, Array cons
 template<class Array, class Weight>
 bool MultidimRegression<Array,Weight>::regressionStep()
 {
-  // compute X'X
-  ArraySquareX prod;
-  prod.move(multLeftTranspose(p_x_->asDerived()));
-  // compute (X'X)^{-1}
-//  GInvertSymMatrix<ArraySquareX>()(prod);
-  // compute (X'X)^{-1}X'Y
-  coefs_.move(mult(invert(prod.symmetrize()), multLeftTranspose(p_x_->asDerived(), p_y_->asDerived())));
-  //coefs_.move(mult(prod, multLeftTranspose(p_x_->asDerived(), p_y_->asDerived())));
+  // accumulate X'X and X'Y
+  NormalEquations eq(p_x_->cols(), p_y_->cols());
+  eq.add(p_x_->asDerived(), p_y_->asDerived());
+  solve(eq);
   return true;
 }
 
@@ -113,17 +122,40 @@ bool MultidimRegression<Array,Weight>::regressionStep()
 template<class Array, class Weight>
 bool MultidimRegression<Array,Weight>::regressionStep(Weight const& weights)
 {
-  // compute X'WX
-  ArraySquareX prod;
-  prod.move(weightedMultLeftTranspose(p_x_->asDerived(), weights));
-  // compute (X'WX)^{-1}
-  //GInvertSymMatrix<ArraySquareX>()(prod);
-  // compute (X'WX)^{-1}X'WY
-  coefs_.move(mult(invert(prod.symmetrize()), wmultLeftTranspose(p_x_->asDerived(), p_y_->asDerived(), weights)));
-//  coefs_.move(mult(prod, wmultLeftTranspose(p_x_->asDerived(), p_y_->asDerived(), weights)));
+  // accumulate X'WX and X'WY
+  NormalEquations eq(p_x_->cols(), p_y_->cols());
+  eq.add(p_x_->asDerived(), p_y_->asDerived(), weights);
+  solve(eq);
   return true;
 }
 
+/* compute the regression function from accumulated normal equations. */
+template<class Array, class Weight>
+bool MultidimRegression<Array,Weight>::run(NormalEquations const& eq)
+{
+  if (eq.nbSample() <= 0)
+  { this->msg_error_ = STKERROR_NO_ARG(MultidimRegression::run,no sample accumulated);
+    return false;
+  }
+  solve(eq);
+  return true;
+}
+
+/* solve the normal equations. */
+template<class Array, class Weight>
+void MultidimRegression<Array,Weight>::solve(NormalEquations const& eq)
+{
+  // solve X'WX coefs = X'WY, use a generalized inverse if X'WX is singular
+  if (!eq.solve(coefs_))
+  {
+    SymEigen<ArraySquareX> decomp(eq.xtx());
+    decomp.run();
+    ArraySquareX ginv;
+    decomp.ginv(ginv);
+    coefs_.move(mult(ginv, eq.xty()));
+  }
+}
+
 /* Compute the predicted outputs by the regression function. */
 template<class Array, class Weight>
 bool MultidimRegression<Array,Weight>::predictionStep()
@@ -0,0 +1,211 @@
+/*--------------------------------------------------------------------*/
+/*     Copyright (C) 2004-2016  Serge Iovleff, Université Lille 1, Inria
+
+    This program is free software; you can redistribute it and/or modify
+    it under the terms of the GNU Lesser General Public License as
+    published by the Free Software Foundation; either version 2 of the
+    License, or (at your option) any later version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU Lesser General Public License for more details.
+
+    You should have received a copy of the GNU Lesser General Public
+    License along with this program; if not, write to the
+    Free Software Foundation, Inc.,
+    59 Temple Place,
+    Suite 330,
+    Boston, MA 02111-1307
+    USA
+
+    Contact : S..._Dot_I..._At_stkpp_Dot_org (see copyright for ...)
+*/
+
+/*
+ * Project:  STKernel::Base
+ * Purpose:  Wall-clock profiling of named sections of code.
+ * Author:   Serge Iovleff, S..._Dot_I..._At_stkpp_Dot_org (see copyright for ...)
+ *
+ **/
+
+/** @file STK_Profiler.h
+ *  @brief In this file we define the Profiler and ScopedTimer classes
+ *  allowing to measure the wall-clock time spent in named sections of code.
+ **/
+
+#ifndef STK_PROFILER_H
+#define STK_PROFILER_H
+
+#include <chrono>
+#include <map>
+#include <vector>
+#include <ostream>
+
+#include <Sdk.h>
+
+namespace STK
+{
+/** @ingroup Base
+ *  @brief The Profiler class accumulates the wall-clock time and the number
+ *  of calls of named sections of code. It can also store series of values
+ *  (e.g. the successive values of a log-likelihood) and counters.
+ *
+ *  The sections are timed using a ScopedTimer. A section can be timed inside
+ *  another one, thus the times are inclusive. All the methods modifying a
+ *  profiler can be called concurrently by several threads.
+ *
+ *  The sections timed by a ScopedTimer contain wall-clock times. A section
+ *  filled using add() with times accumulated by several threads (e.g. the
+ *  "idData.eStep" sections of the MixtureComposer) contains a CPU time summed
+ *  over the threads, which can be greater than the wall-clock time of the
+ *  enclosing section. ScopedTimer should not be used in a parallel loop:
+ *  each destruction enters a critical section.
+ *  @sa ScopedTimer
+ **/
+class Profiler
+{
+  public:
+    /** time and number of calls of a section */
+    struct Entry
+    {
+      Entry(): time_(0.), nbCall_(0) {}
+      /** elapsed time in seconds */
+      Real time_;
+      /** number of calls */
+      int nbCall_;
+    };
+    /** type of the container of the sections */
+    typedef std::map<String, Entry> Entries;
+    /** type of the container of the series. Each name is associated to a list
+     *  of series (one for each run) */
+    typedef std::map<String, std::vector< std::vector<Real> > > Series;
+
+    /** default constructor */
+    inline Profiler(): entries_(), series_() {}
+    /** @return the sections */
+    inline Entries const& entries() const { return entries_;}
+    /** @return the series */
+    inline Series const& series() const { return series_;}
+
+    /** add a time and a number of calls to a section
+     *  @param name name of the section
+     *  @param time time in seconds
+     *  @param nbCall number of calls
+     **/
+    inline void add(String const& name, Real time, int nbCall = 1)
+    {
+#ifdef _OPENMP
+#pragma omp critical (STK_Profiler)
+#endif
+      {
+        Entry& entry = entries_[name];
+        entry.time_   += time;
+        entry.nbCall_ += nbCall;
+      }
+    }
+    /** increment a counter
+     *  @param name name of the counter
+     *  @param nb value to add
+     **/
+    inline void count(String const& name, int nb = 1) { add(name, 0., nb);}
+    /** add a series of values
+     *  @param name name of the series
+     *  @param values the values
+     **/
+    inline void addSeries(String const& name, std::vector<Real> const& values)
+    {
+#ifdef _OPENMP
+#pragma omp critical (STK_Profiler)
+#endif
+      { series_[name].push_back(values);}
+    }
+    /** add the sections and the series of an other profiler
+     *  @param other the profiler to merge
+     **/
+    void merge(Profiler const& other)
+    {
+      for (Entries::const_iterator it = other.entries_.begin(); it != other.entries_.end(); ++it)
+      { add(it->first, it->second.time_, it->second.nbCall_);}
+      for (Series::const_iterator it = other.series_.begin(); it != other.series_.end(); ++it)
+      {
+        for (size_t l = 0; l < it->second.size(); ++l) { addSeries(it->first, it->second[l]);}
+      }
+    }
+    /** remove all the sections and series */
+    inline void clear() { entries_.clear(); series_.clear();}
+    /** write a report in the stream os
+     *  @param os the output stream
+     **/
+    void write(ostream& os) const
+    {
+      os << _T("section\ttime\tnbCall\n");
+      for (Entries::const_iterator it = entries_.begin(); it != entries_.end(); ++it)
+      { os << it->first << _T("\t") << it->second.time_ << _T("\t") << it->second.nbCall_ << _T("\n");}
+      for (Series::const_iterator it = series_.begin(); it != series_.end(); ++it)
+      {
+        for (size_t l = 0; l < it->second.size(); ++l)
+        {
+          os << it->first << _T("[") << l << _T("] =");
+          for (size_t i = 0; i < it->second[l].size(); ++i) { os << _T(" ") << it->second[l][i];}
+          os << _T("\n");
+        }
+      }
+    }
+
+  private:
+    /** the timed sections */
+    Entries entries_;
+    /** the series */
+    Series series_;
+};
+
+/** @ingroup Base
+ *  @brief The ScopedTimer class measures the wall-clock time elapsed between
+ *  its construction and its destruction and add it to a section of a Profiler.
+ *  If the profiler is null nothing is done, so that a timer can be left in the
+ *  code at no cost when the profiling is disabled.
+ *  @code
+ *    {
+ *      ScopedTimer timer(p_profiler, _T("eStep"));
+ *      ... // code to time
+ *    }
+ *  @endcode
+ **/
+class ScopedTimer
+{
+  public:
+    /** type of the clock used */
+    typedef std::chrono::steady_clock Clock;
+    /** constructor
+     *  @param p_profiler the profiler to update, can be null
+     *  @param name name of the section
+     **/
+    inline ScopedTimer( Profiler* p_profiler, String const& name)
+                      : p_profiler_(p_profiler), name_()
+    { if (p_profiler_) { name_ = name; start_ = Clock::now();}}
+    /** constructor. The name of the section is "prefix.name".
+     *  @param p_profiler the profiler to update, can be null
+     *  @param prefix,name prefix and name of the section
+     **/
+    inline ScopedTimer( Profiler* p_profiler, String const& prefix, String const& name)
+                      : p_profiler_(p_profiler), name_()
+    { if (p_profiler_) { name_ = prefix + _T(".") + name; start_ = Clock::now();}}
+    /** destructor. Add the elapsed time to the section. */
+    inline ~ScopedTimer() { if (p_profiler_) { p_profiler_->add(name_, elapsed());}}
+    /** @return the elapsed time in seconds since the construction */
+    inline Real elapsed() const
+    { return std::chrono::duration<Real>(Clock::now() - start_).count();}
+
+  private:
+    /** the profiler to update */
+    Profiler* p_profiler_;
+    /** name of the section */
+    String name_;
+    /** starting time */
+    Clock::time_point start_;
+};
+
+} // namespace STK
+
+#endif /*STK_PROFILER_H*/
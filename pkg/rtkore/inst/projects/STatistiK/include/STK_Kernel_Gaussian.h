@@ -128,6 +128,10 @@ class Gaussian: public IKernelBase<Array>
      **/
     virtual Real value(Type const& v) const;
 
+  protected:
+    /** compute the Gram matrix using the squared distances between the rows */
+    virtual void computeGram();
+
   private:
     /** bandwidth of the kernel */
     Real width_;
@@ -139,6 +143,20 @@ Real Gaussian<Array>::comp(int i, int j) const
                  : std::exp(-(p_data_->row(i) - p_data_->row(j)).norm2()/(2.*width_));
 }
 
+template<class Array>
+void Gaussian<Array>::computeGram()
+{
+  this->computeSquaredDistances();
+#ifdef _OPENMP
+#pragma omp parallel for
+#endif
+  for (int j= gram_.begin(); j < gram_.end(); ++j)
+  {
+    for (int i= gram_.begin(); i < gram_.end(); ++i)
+    { gram_(i,j) = std::exp(-gram_(i,j)/(2.*width_));}
+  }
+}
+
 template<class Array>
 Real Gaussian<Array>::value(Type const& v) const
 { return std::exp(-v*v/(2.*width_));}
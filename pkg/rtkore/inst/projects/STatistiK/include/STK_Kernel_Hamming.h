@@ -154,19 +154,27 @@ class Hamming: public IKernelBase<Array>
     Real lambda_;
     /** diagonal element of the kernel */
     Real diagElt_;
+    /** factors of each variable when the values are equal or not */
+    CPointX eqFactor_, neqFactor_;
     /** factors of the values */
     Stat::MultiFactor<Array> factors_;
-    /** Compute the diagonal element of the kernel*/
+    /** Compute the diagonal element and the factors of the kernel */
     void computeDiagonalElement();
 };
 
-/* Compute the diagonal element of the kernel*/
+/* Compute the diagonal element and the factors of the kernel */
 template<class Array>
 void Hamming<Array>::computeDiagonalElement()
 {
    diagElt_ = 1.;
+   eqFactor_.resize(factors_.nbLevels().range());
+   neqFactor_.resize(factors_.nbLevels().range());
    for(int j=factors_.nbLevels().begin(); j < factors_.nbLevels().end(); ++j)
-   { diagElt_ *= lambda_*lambda_*(factors_.nbLevels()[j]-1) + 1;}
+   {
+     eqFactor_[j]  = lambda_*lambda_*(factors_.nbLevels()[j]-1) + 1.;
+     neqFactor_[j] = lambda_*(lambda_*(factors_.nbLevels()[j]-2) + 2.);
+     diagElt_ *= eqFactor_[j];
+   }
 }
 
 template<class Array>
@@ -175,16 +183,10 @@ inline Real Hamming<Array>::diag(int i) const { return diagElt_;}
 template<class Array>
 Real Hamming<Array>::comp(int i, int j) const
 {
-  typedef typename hidden::Traits<Array>::Row RowVector;
   if (hasRun_) return gram_(i,j);
-  // create references on row i and j
-  RowVector ind1(p_data_->row(i), true), ind2(p_data_->row(j), true);
   Real value = 1.;
-  for(int j=factors_.nbLevels().begin(); j < factors_.nbLevels().end(); ++j)
-  {
-    value *= (ind1[j]==ind2[j]) ? lambda_*lambda_*(factors_.nbLevels()[j]-1) + 1.
-                                : lambda_*(lambda_*(factors_.nbLevels()[j]-2) + 2.);
-  }
+  for(int l=eqFactor_.begin(); l < eqFactor_.end(); ++l)
+  { value *= (p_data_->elt(i,l)==p_data_->elt(j,l)) ? eqFactor_[l] : neqFactor_[l];}
   return value;
 }
 
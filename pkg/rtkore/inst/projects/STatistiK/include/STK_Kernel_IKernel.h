@@ -38,6 +38,10 @@
 
 #include <Sdk.h>
 #include <Arrays/include/STK_CArraySquare.h>
+#include <Arrays/include/STK_CArray.h>
+#include <Arrays/include/STK_CArrayVector.h>
+#include <Algebra/include/STK_SymEigen.h>
+#include "STK_Law_UniformDiscrete.h"
 
 namespace STK
 {
@@ -55,16 +59,26 @@ namespace Kernel
  *  is called a positive definite (p.d.) kernel on \f$\mathcal X\f$ if
  *  \f$\sum_{i,j=1}^n c_i c_j K(x_i, x_j) \ge 0\f$ holds for any
  *  \f$ n\in \mathbb{N}, x_1, \dots, x_n\in \mathcal X, c_1, \dots, c_n \in \mathbb{R}\f$.
+ *
+ *  For large data sets, the kernel can be approximated by a low rank feature
+ *  map \f$ \Phi \f$ of size (n, m) using the Nystr\"om method: m landmarks
+ *  \f$ x_{l_1},\ldots,x_{l_m} \f$ are sampled among the individuals and
+ *  \f[ \Phi = C W^{-1/2}, \quad C_{il} = k(x_i,x_{l}),
+ *       \quad W_{lm} = k(x_l,x_m), \f]
+ *  so that \f$ \Phi\Phi^T \f$ approximates the Gram matrix.
  **/
 class IKernel: public IRunnerBase
 {
   public:
     /** default constructor */
-    inline IKernel(): IRunnerBase(), gram_() {}
+    inline IKernel(): IRunnerBase(), gram_(), features_(), featuresNorm2_() {}
     /** copy constructor
      *  @param kernel kernel to copy
      **/
-    inline IKernel(IKernel const& kernel): IRunnerBase(kernel), gram_(kernel.gram_) {}
+    inline IKernel(IKernel const& kernel)
+                  : IRunnerBase(kernel), gram_(kernel.gram_), features_(kernel.features_)
+                  , featuresNorm2_(kernel.featuresNorm2_)
+    {}
     /** destructor */
     inline virtual ~IKernel() {}
 
@@ -77,6 +91,19 @@ class IKernel: public IRunnerBase
      *  @note if the run method is not used, the gram matrix is empty
      **/
     inline CSquareX const& gram() const { return gram_;}
+    /** @return @c true if the gram matrix has been computed */
+    inline bool hasGram() const { return !gram_.empty();}
+    /** @return the low rank feature map of the kernel
+     *  @note if the computeFeatures method is not used, the feature map is empty
+     **/
+    inline CArrayXX const& features() const { return features_;}
+    /** @return the squared norms \f$ \|\phi(x_i)\|^2 \f$ of the rows of the
+     *  low rank feature map
+     *  @note if the computeFeatures method is not used, the vector is empty
+     **/
+    inline CVectorX const& featuresNorm2() const { return featuresNorm2_;}
+    /** @return @c true if the low rank feature map has been computed */
+    inline bool hasFeatures() const { return !features_.empty();}
 
     // method using the gram matrix
     /** @return computed value of the kernel for the ith and jth individuals.
@@ -118,11 +145,76 @@ class IKernel: public IRunnerBase
      **/
     virtual int nbVariable() const =0;
 
+    /** compute the low rank feature map of the kernel using the Nystr\"om
+     *  method with @c nbLandmark landmarks sampled among the individuals.
+     *  @param nbLandmark number of landmarks
+     *  @return @c true if the computation is successful, @c false otherwise
+     **/
+    bool computeFeatures(int nbLandmark);
+
   protected:
     /** the resulting gram_ matrix */
     CSquareX gram_;
+    /** the low rank feature map */
+    CArrayXX features_;
+    /** the squared norms of the rows of the feature map */
+    CVectorX featuresNorm2_;
 };
 
+inline bool IKernel::computeFeatures(int nbLandmark)
+{
+  int n = nbSample();
+  if (nbLandmark <= 0 || n <= 0)
+  { msg_error_ = STKERROR_1ARG(IKernel::computeFeatures,nbLandmark,invalid number of landmarks);
+    return false;
+  }
+  nbLandmark = std::min(nbLandmark, n);
+  // sample the landmarks without repetition
+  CVectorXi indexes(n), landmarks(nbLandmark);
+  for(int i=indexes.begin(); i< indexes.end(); ++i) { indexes[i] = i;}
+  Range rind(indexes.range());
+  for (int l= landmarks.begin(); l < landmarks.end(); ++l)
+  {
+    int i = Law::UniformDiscrete::rand(rind.begin(), rind.lastIdx());
+    landmarks[l] = indexes[i];
+    indexes.swap(i, rind.lastIdx());
+    rind.decLast(1);
+  }
+  // Gram matrix of the landmarks and its eigenvalues decomposition
+  CSquareX w(landmarks.range());
+  for (int l= w.begin(); l < w.end(); ++l)
+  {
+    w(l,l) = diag(landmarks[l]);
+    for (int m= l+1; m < w.end(); ++m)
+    { w(l,m) = w(m,l) = comp(landmarks[l], landmarks[m]);}
+  }
+  SymEigen<CSquareX> decomp(w);
+  if (!decomp.run())
+  { msg_error_ = decomp.error();
+    return false;
+  }
+  // scaled rotation U D^{-1/2}, the null eigenvalues are discarded
+  Real tol = Arithmetic<Real>::epsilon() * nbLandmark * decomp.eigenValues().maxElt();
+  CSquareX rot(decomp.rotation());
+  for (int m= rot.begin(); m < rot.end(); ++m)
+  {
+    Real lambda = decomp.eigenValues()[m];
+    rot.col(m) *= (lambda > tol) ? 1./std::sqrt(lambda) : 0.;
+  }
+  // feature map C U D^{-1/2}
+  CArrayXX c(nbSample(), landmarks.range());
+  for (int l= c.beginCols(); l < c.endCols(); ++l)
+  {
+    for (int i= c.beginRows(); i < c.endRows(); ++i)
+    { c(i,l) = (i == landmarks[l]) ? w(l,l) : comp(i, landmarks[l]);}
+  }
+  features_ = c * rot;
+  featuresNorm2_.resize(features_.rows());
+  for (int i= featuresNorm2_.begin(); i < featuresNorm2_.end(); ++i)
+  { featuresNorm2_[i] = features_.row(i).norm2();}
+  return true;
+}
+
 
 } // namespace Kernel
 
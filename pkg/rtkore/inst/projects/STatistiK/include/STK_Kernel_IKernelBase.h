@@ -37,6 +37,10 @@
 #define STK_KERNEL_IKERNELBASE_H
 
 #include "STK_Kernel_IKernel.h"
+#include <Arrays/include/STK_CArray.h>
+#include <Arrays/include/STK_CArrayVector.h>
+#include <Arrays/include/STK_CArrayPoint.h>
+#include "STK_Stat_Functors.h"
 
 namespace STK
 {
@@ -88,28 +92,96 @@ class IKernelBase: public IKernel
   protected:
     /** pointer on the data set */
     Array const* p_data_;
+
+    /** compute the Gram matrix. This default implementation split the upper
+     *  triangular part of the matrix in square tiles of size @c blockSize_,
+     *  the tiles are computed in parallel using @c comp(i,j) and copied in
+     *  the lower part. Derived classes can re-implement it with a more
+     *  efficient computation.
+     **/
+    virtual void computeGram();
+    /** compute the inner products of the (centered if @c center is @c true)
+     *  rows of the data set in the Gram matrix using a (blocked) matrix product.
+     *  @param center @c true if the data set have to be centered
+     **/
+    void computeInnerProducts(bool center);
+    /** compute the squared distances between the rows of the data set
+     *  $ \|x_i\|^2+\|x_j\|^2-2 <x_i,x_j> $ in the Gram matrix. The data
+     *  set is centered in order to reduce the cancellation errors.
+     **/
+    void computeSquaredDistances();
+
+    /** size of the tiles used in the default computation of the Gram matrix */
+    static const int blockSize_ = 64;
 };
 
 template<class Array>
 bool IKernelBase<Array>::run()
 {
   if(!p_data_) return false;
+  this->hasRun_ = false; // comp(i,j) must not use the gram matrix
   gram_.resize(p_data_->rows());
-  // upper part
-  for (int j= gram_.begin(); j < gram_.end(); ++j)
+  computeGram();
+  this->hasRun_ = true;
+  return true;
+}
+
+template<class Array>
+void IKernelBase<Array>::computeGram()
+{
+  int first = gram_.begin(), last = gram_.end();
+  int nbBlock = (gram_.size() + blockSize_ - 1)/blockSize_;
+  int nbTile  = nbBlock*(nbBlock+1)/2;
+#ifdef _OPENMP
+#pragma omp parallel for schedule(dynamic)
+#endif
+  for (int t = 0; t < nbTile; ++t)
+  {
+    // get the tile (bi,bj) with bi <= bj
+    int bi = t, bj = 0;
+    while (bi > bj) { ++bj; bi -= bj;}
+    int iBeg = first + bi*blockSize_, iEnd = std::min(iBeg + blockSize_, last);
+    int jBeg = first + bj*blockSize_, jEnd = std::min(jBeg + blockSize_, last);
+    for (int j= jBeg; j < jEnd; ++j)
+    {
+      for (int i= iBeg; i < std::min(iEnd, j); ++i)
+      { gram_(j,i) = gram_(i,j) = this->comp(i,j);}
+      if (j < iEnd) { gram_(j,j) = this->diag(j);}
+    }
+  }
+}
+
+template<class Array>
+void IKernelBase<Array>::computeInnerProducts(bool center)
+{
+  CArrayXX x(p_data_->rows(), p_data_->cols());
+  for (int j= x.beginCols(); j < x.endCols(); ++j)
+  {
+    for (int i= x.beginRows(); i < x.endRows(); ++i)
+    { x(i,j) = (Real)p_data_->elt(i,j);}
+  }
+  if (center)
   {
-    { gram_(j,j) = this->diag(j);}
-    for (int i= j+1; i < gram_.end(); ++i)
-    { gram_(i,j) = this->comp(i,j);}
+    CPointX mu = Stat::mean(x);
+    for (int j= x.beginCols(); j < x.endCols(); ++j) { x.col(j) -= mu[j];}
   }
-  // lower part
+  gram_ = x * x.transpose();
+}
+
+template<class Array>
+void IKernelBase<Array>::computeSquaredDistances()
+{
+  computeInnerProducts(true);
+  CVectorX norm2(gram_.range());
+  for (int i= gram_.begin(); i < gram_.end(); ++i) { norm2[i] = gram_(i,i);}
+#ifdef _OPENMP
+#pragma omp parallel for
+#endif
   for (int j= gram_.begin(); j < gram_.end(); ++j)
   {
-    for (int i= j+1; i < gram_.end(); ++i)
-    { gram_(j,i) = gram_(i,j);}
+    for (int i= gram_.begin(); i < gram_.end(); ++i)
+    { gram_(i,j) = (i == j) ? 0. : std::max(norm2[i] + norm2[j] - 2.*gram_(i,j), 0.);}
   }
-  this->hasRun_ = true;
-  return true;
 }
 
 
@@ -125,6 +125,10 @@ class Laplace: public IKernelBase<Array>
      **/
     virtual Real value(Type const& v) const;
 
+  protected:
+    /** compute the Gram matrix using the squared distances between the rows */
+    virtual void computeGram();
+
   private:
     /** bandwidth of the kernel */
     Real width_;
@@ -137,6 +141,20 @@ inline Real Laplace<Array>::comp(int i, int j) const
                  : std::exp(-(p_data_->row(i) - p_data_->row(j)).norm()/width_);
 }
 
+template<class Array>
+void Laplace<Array>::computeGram()
+{
+  this->computeSquaredDistances();
+#ifdef _OPENMP
+#pragma omp parallel for
+#endif
+  for (int j= gram_.begin(); j < gram_.end(); ++j)
+  {
+    for (int i= gram_.begin(); i < gram_.end(); ++i)
+    { gram_(i,j) = std::exp(-std::sqrt(gram_(i,j))/width_);}
+  }
+}
+
 template<class Array>
 inline Real Laplace<Array>::value(Type const& v) const
 { return std::exp(-std::abs(v)/width_);}
@@ -223,6 +241,10 @@ class Exponential: public IKernelBase<Array>
      **/
     virtual Real value(Type const& v) const;
 
+  protected:
+    /** compute the Gram matrix using the squared distances between the rows */
+    virtual void computeGram();
+
   private:
     /** bandwidth of the kernel */
     Real width_;
@@ -235,6 +257,20 @@ inline Real Exponential<Array>::comp(int i, int j) const
                  : std::exp(-(p_data_->row(i) - p_data_->row(j)).norm()/width_);
 }
 
+template<class Array>
+void Exponential<Array>::computeGram()
+{
+  this->computeSquaredDistances();
+#ifdef _OPENMP
+#pragma omp parallel for
+#endif
+  for (int j= gram_.begin(); j < gram_.end(); ++j)
+  {
+    for (int i= gram_.begin(); i < gram_.end(); ++i)
+    { gram_(i,j) = std::exp(-std::sqrt(gram_(i,j))/width_);}
+  }
+}
+
 template<class Array>
 inline Real Exponential<Array>::value(Type const& v) const
 { return std::exp(-std::abs(v)/width_);}
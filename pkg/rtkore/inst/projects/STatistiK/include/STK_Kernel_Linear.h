@@ -102,6 +102,10 @@ class Linear: public IKernelBase<Array>
      *  @param i,j indexes of the individuals
      **/
     virtual Real comp(int i, int j) const;
+
+  protected:
+    /** compute the Gram matrix using a matrix product */
+    virtual void computeGram() { this->computeInnerProducts(false);}
 };
 
 /* virtual method.
@@ -139,6 +139,10 @@ class Polynomial: public IKernelBase<Array>
      **/
     virtual Real comp(int i, int j) const;
 
+  protected:
+    /** compute the Gram matrix using a matrix product */
+    virtual void computeGram();
+
   private:
     /** degree of the kernel */
     Real d_;
@@ -161,6 +165,19 @@ inline Real Polynomial<Array>::comp(int i, int j) const
 { return hasRun_ ? gram_(i,j)
                  :  std::pow(p_data_->row(i).dot(p_data_->row(j)) + shift_, d_);}
 
+template<class Array>
+void Polynomial<Array>::computeGram()
+{
+  this->computeInnerProducts(false);
+#ifdef _OPENMP
+#pragma omp parallel for
+#endif
+  for (int j= gram_.begin(); j < gram_.end(); ++j)
+  {
+    for (int i= gram_.begin(); i < gram_.end(); ++i)
+    { gram_(i,j) = std::pow(gram_(i,j) + shift_, d_);}
+  }
+}
 
 } // namespace Kernel
 
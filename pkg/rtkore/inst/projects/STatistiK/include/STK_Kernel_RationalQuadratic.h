@@ -128,6 +128,10 @@ class RationalQuadratic: public IKernelBase<Array>
      **/
     virtual Real value(Type const& v) const;
 
+  protected:
+    /** compute the Gram matrix using the squared distances between the rows */
+    virtual void computeGram();
+
   private:
     /** shift of the kernel */
     Real shift_;
@@ -141,6 +145,20 @@ Real RationalQuadratic<Array>::comp(int i, int j) const
   return 1. - aux/(aux + shift_);
 }
 
+template<class Array>
+void RationalQuadratic<Array>::computeGram()
+{
+  this->computeSquaredDistances();
+#ifdef _OPENMP
+#pragma omp parallel for
+#endif
+  for (int j= gram_.begin(); j < gram_.end(); ++j)
+  {
+    for (int i= gram_.begin(); i < gram_.end(); ++i)
+    { gram_(i,j) = 1. - gram_(i,j)/(gram_(i,j) + shift_);}
+  }
+}
+
 template<class Array>
 Real RationalQuadratic<Array>::value(Type const& v) const
 { return 1- v*v/(v*v + shift_);}
@@ -135,6 +135,7 @@ inline Real Beta::rand() const
 #ifdef _OPENMP
 //#pragma omp critical
 #endif
+  if (RandStream* p_stream = currentStream()) return p_stream->randBeta(alpha_, beta_);
   GetRNGstate(); Real s = Rf_rbeta(alpha_, beta_); PutRNGstate(); return s;
 }
 
@@ -151,6 +152,7 @@ inline Real Beta::rand( Real const& alpha, Real const& beta)
 #ifdef _OPENMP
 //#pragma omp critical
 #endif
+  if (RandStream* p_stream = currentStream()) return p_stream->randBeta(alpha, beta);
   GetRNGstate(); Real s = Rf_rbeta(alpha, beta); PutRNGstate(); return s;
 }
 
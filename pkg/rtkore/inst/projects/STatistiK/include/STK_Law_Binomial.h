@@ -181,6 +181,7 @@ inline int Binomial::rand() const
 #ifdef _OPENMP
 //#pragma omp critical
 #endif
+if (RandStream* p_stream = currentStream()) return p_stream->randBinomial(n_, prob_);
 GetRNGstate(); int s = Rf_rbinom(n_, prob_); PutRNGstate(); return s;
 }
 
@@ -197,6 +198,7 @@ inline int Binomial::rand(int n, Real const& prob)
 #ifdef _OPENMP
 //#pragma omp critical
 #endif
+if (RandStream* p_stream = currentStream()) return p_stream->randBinomial(n, prob);
 GetRNGstate(); int s = Rf_rbinom(n, prob); PutRNGstate(); return s;
 }
 
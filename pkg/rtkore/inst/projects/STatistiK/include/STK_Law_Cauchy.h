@@ -191,6 +191,7 @@ inline Real Cauchy::rand() const
 #ifdef _OPENMP
 //#pragma omp critical
 #endif
+if (RandStream* p_stream = currentStream()) return p_stream->randCauchy(mu_, scale_);
 GetRNGstate(); Real s = Rf_rcauchy(mu_, scale_); PutRNGstate(); return s;
 }
 
@@ -208,6 +209,7 @@ inline Real Cauchy::rand( Real const& mu, Real const& scale)
 #ifdef _OPENMP
 //#pragma omp critical
 #endif
+if (RandStream* p_stream = currentStream()) return p_stream->randCauchy(mu, scale);
 GetRNGstate(); Real s = Rf_rcauchy(mu, scale); PutRNGstate(); return s;
 }
 
@@ -144,6 +144,7 @@ inline Real ChiSquared::rand() const
 #ifdef _OPENMP
 //#pragma omp critical
 #endif
+ if (RandStream* p_stream = currentStream()) return p_stream->randChiSquared(df_);
  GetRNGstate(); Real s = Rf_rchisq(df_); PutRNGstate(); return s;
 }
 
@@ -160,6 +161,7 @@ inline Real ChiSquared::rand(int df)
 #ifdef _OPENMP
 //#pragma omp critical
 #endif
+if (RandStream* p_stream = currentStream()) return p_stream->randChiSquared(df);
 GetRNGstate(); Real s = Rf_rchisq(df); PutRNGstate(); return s;
 }
 
@@ -147,6 +147,7 @@ inline Real Exponential::rand() const
 #ifdef _OPENMP
 //#pragma omp critical
 #endif
+if (RandStream* p_stream = currentStream()) return p_stream->randExp(scale_);
 GetRNGstate(); Real s = Rf_rexp(scale_); PutRNGstate(); return s;
 }
 
@@ -163,6 +164,7 @@ inline Real Exponential::rand( Real const& scale)
 #ifdef _OPENMP
 //#pragma omp critical
 #endif
+if (RandStream* p_stream = currentStream()) return p_stream->randExp(scale);
 GetRNGstate(); Real s = Rf_rexp(scale); PutRNGstate(); return s;
 }
 
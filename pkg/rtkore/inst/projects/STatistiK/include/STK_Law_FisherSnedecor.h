@@ -154,6 +154,7 @@ inline Real FisherSnedecor::rand() const
 #ifdef _OPENMP
 //#pragma omp critical
 #endif
+if (RandStream* p_stream = currentStream()) return p_stream->randFisherSnedecor(df1_, df2_);
 GetRNGstate(); Real s = Rf_rf(df1_, df2_); PutRNGstate(); return s;
 }
 
@@ -170,6 +171,7 @@ inline Real FisherSnedecor::rand( int df1, int df2)
 #ifdef _OPENMP
 //#pragma omp critical
 #endif
+if (RandStream* p_stream = currentStream()) return p_stream->randFisherSnedecor(df1, df2);
 GetRNGstate(); Real s = Rf_rf(df1, df2); PutRNGstate(); return s;
 }
 
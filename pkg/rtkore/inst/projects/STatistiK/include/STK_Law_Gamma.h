@@ -195,6 +195,7 @@ inline Real Gamma::rand() const
 #ifdef _OPENMP
 //#pragma omp critical
 #endif
+if (RandStream* p_stream = currentStream()) return p_stream->randGamma(a_, b_);
 GetRNGstate(); Real s = Rf_rgamma(a_, b_); PutRNGstate(); return s;
 }
 
@@ -211,6 +212,7 @@ inline Real Gamma::rand( Real const& a, Real const& b)
 #ifdef _OPENMP
 //#pragma omp critical
 #endif
+if (RandStream* p_stream = currentStream()) return p_stream->randGamma(a, b);
 GetRNGstate(); Real s = Rf_rgamma(a, b); PutRNGstate(); return s;
 }
 
@@ -160,6 +160,7 @@ inline int Geometric::rand() const
 #ifdef _OPENMP
 //#pragma omp critical
 #endif
+if (RandStream* p_stream = currentStream()) return p_stream->randGeometric(prob_);
 GetRNGstate(); int s = Rf_rgeom(prob_); PutRNGstate(); return s;
 }
 
@@ -176,6 +177,7 @@ inline int Geometric::rand(Real const& prob)
 #ifdef _OPENMP
 //#pragma omp critical
 #endif
+if (RandStream* p_stream = currentStream()) return p_stream->randGeometric(prob);
 GetRNGstate(); int s = Rf_rgeom(prob); PutRNGstate(); return s;
 }
 
@@ -192,6 +192,7 @@ inline int HyperGeometric::rand() const
 #ifdef _OPENMP
 //#pragma omp critical
 #endif
+if (RandStream* p_stream = currentStream()) return p_stream->randHyperGeometric(nbSuccesses_, nbFailures_, nbDraws_);
 GetRNGstate(); int s = Rf_rhyper(nbSuccesses_, nbFailures_, nbDraws_); PutRNGstate(); return s;
 }
 
@@ -215,6 +216,7 @@ inline Integer HyperGeometric::rand( int nbSuccesses, int nbFailures, int nbDraw
 #ifdef _OPENMP
 //#pragma omp critical
 #endif
+  if (RandStream* p_stream = currentStream()) return p_stream->randHyperGeometric(nbSuccesses, nbFailures, nbDraws);
   GetRNGstate(); int s = Rf_rhyper(nbSuccesses, nbFailures, nbDraws); PutRNGstate(); return s;
 }
 
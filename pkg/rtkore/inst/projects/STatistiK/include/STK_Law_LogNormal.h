@@ -179,6 +179,7 @@ inline Real LogNormal::rand() const
 #ifdef _OPENMP
 //#pragma omp critical
 #endif
+if (RandStream* p_stream = currentStream()) return p_stream->randLogNormal(mu_, sigma_);
 GetRNGstate(); Real s = Rf_rlnorm(mu_, sigma_); PutRNGstate(); return s;
 }
 
@@ -195,6 +196,7 @@ inline Real LogNormal::rand( Real const& mu, Real const& sigma)
 #ifdef _OPENMP
 //#pragma omp critical
 #endif
+if (RandStream* p_stream = currentStream()) return p_stream->randLogNormal(mu, sigma);
 GetRNGstate(); Real s = Rf_rlnorm(mu, sigma); PutRNGstate(); return s;
 }
 
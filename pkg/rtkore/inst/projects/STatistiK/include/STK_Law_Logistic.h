@@ -182,6 +182,7 @@ inline Real Logistic::rand() const
 #ifdef _OPENMP
 //#pragma omp critical
 #endif
+if (RandStream* p_stream = currentStream()) return p_stream->randLogistic(mu_, scale_);
 GetRNGstate(); Real s = Rf_rlogis(mu_, scale_); PutRNGstate(); return s;
 }
 
@@ -198,6 +199,7 @@ inline Real Logistic::rand( Real const& mu, Real const& scale)
 #ifdef _OPENMP
 //#pragma omp critical
 #endif
+if (RandStream* p_stream = currentStream()) return p_stream->randLogistic(mu, scale);
 GetRNGstate(); Real s = Rf_rlogis(mu, scale); PutRNGstate(); return s;
 }
 
@@ -179,6 +179,7 @@ inline int NegativeBinomial::rand() const
 #ifdef _OPENMP
 //#pragma omp critical
 #endif
+if (RandStream* p_stream = currentStream()) return p_stream->randNegativeBinomial(size_, prob_);
 GetRNGstate(); int s = Rf_rnbinom(size_, prob_); PutRNGstate(); return s;
 }
 
@@ -195,6 +196,7 @@ inline int NegativeBinomial::rand(int size, Real const& prob)
 #ifdef _OPENMP
 //#pragma omp critical
 #endif
+if (RandStream* p_stream = currentStream()) return p_stream->randNegativeBinomial(size, prob);
 GetRNGstate(); int s = Rf_rnbinom(size, prob); PutRNGstate(); return s;
 }
 
@@ -195,6 +195,7 @@ inline Real Normal::rand() const
 #ifdef _OPENMP
 //#pragma omp critical
 #endif
+if (RandStream* p_stream = currentStream()) return p_stream->randGauss(mu_, sigma_);
 GetRNGstate(); Real s = Rf_rnorm(mu_, sigma_); PutRNGstate(); return s;
 }
 
@@ -212,6 +213,7 @@ inline Real Normal::rand( Real const& mu, Real const& scale)
 #ifdef _OPENMP
 //#pragma omp critical
 #endif
+if (RandStream* p_stream = currentStream()) return p_stream->randGauss(mu, scale);
 GetRNGstate(); Real s = Rf_rnorm(mu, scale); PutRNGstate(); return s;
 }
 
@@ -172,6 +172,7 @@ inline int Poisson::rand() const
 #ifdef _OPENMP
 //#pragma omp critical
 #endif
+  if (RandStream* p_stream = currentStream()) return (int)p_stream->randPoisson(lambda_);
   GetRNGstate(); int s = (int)Rf_rpois(lambda_); PutRNGstate(); return s;
 }
 
@@ -189,6 +190,7 @@ inline int Poisson::rand(Real const& lambda)
 #ifdef _OPENMP
 //#pragma omp critical
 #endif
+  if (RandStream* p_stream = currentStream()) return (int)p_stream->randPoisson(lambda);
   GetRNGstate(); int s = (int)Rf_rpois(lambda); PutRNGstate(); return s;
 }
 
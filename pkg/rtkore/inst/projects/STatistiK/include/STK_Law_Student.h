@@ -152,6 +152,7 @@ inline Real Student::rand() const
 #ifdef _OPENMP
 //#pragma omp critical
 #endif
+if (RandStream* p_stream = currentStream()) return p_stream->randStudent(df_);
 GetRNGstate(); Real s = Rf_rt(df_); PutRNGstate(); return s;
 }
 
@@ -168,6 +169,7 @@ inline Real Student::rand( int df)
 #ifdef _OPENMP
 //#pragma omp critical
 #endif
+if (RandStream* p_stream = currentStream()) return p_stream->randStudent(df);
 GetRNGstate(); Real s = Rf_rt(df); PutRNGstate(); return s;
 }
 
@@ -163,6 +163,7 @@ inline Real Uniform::rand() const
 #ifdef _OPENMP
 //#pragma omp critical
 #endif
+  if (RandStream* p_stream = currentStream()) return p_stream->randUnif(a_, b_);
   GetRNGstate(); Real s = Rf_runif(a_, b_); PutRNGstate(); return s;
 }
 
@@ -179,6 +180,7 @@ inline Real Uniform::rand( Real const& a, Real const& b)
 #ifdef _OPENMP
 //#pragma omp critical
 #endif
+  if (RandStream* p_stream = currentStream()) return p_stream->randUnif(a, b);
   GetRNGstate(); Real s = Rf_runif(a, b); PutRNGstate(); return s;
 }
 
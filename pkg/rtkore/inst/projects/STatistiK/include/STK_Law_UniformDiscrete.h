@@ -153,6 +153,7 @@ inline int UniformDiscrete::rand() const
 #ifdef _OPENMP
 //#pragma omp critical
 #endif
+if (RandStream* p_stream = currentStream()) return a_ + p_stream->rand(double(n_));
 GetRNGstate(); Real s = a_ + Rf_runif(0, double(n_)); PutRNGstate(); return s;
 }
 
@@ -192,6 +193,7 @@ inline int UniformDiscrete::rand( int a, int b)
 #ifdef _OPENMP
 //#pragma omp critical
 #endif
+  if (RandStream* p_stream = currentStream()) return a + p_stream->rand(double(b - a + 1));
   GetRNGstate(); Real s = a + Rf_runif(0, double(b - a + 1)); PutRNGstate(); return s;
 }
 
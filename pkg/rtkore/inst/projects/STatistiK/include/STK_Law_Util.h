@@ -48,6 +48,12 @@ namespace Law
 /** default random number generator. */
 static RandBase generator;
 
+/** @return a 53 bits seed for a RandStream drawn from the generator. Seeds
+ *  should be drawn by the calling thread before entering a parallel region.
+ **/
+inline uint64_t randSeed()
+{ return uint64_t(generator.randUnif() * 9007199254740992.);}
+
 /** @ingroup Law
  * list of the univariate distribution laws
  **/
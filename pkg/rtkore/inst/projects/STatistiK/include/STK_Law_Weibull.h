@@ -158,6 +158,7 @@ inline Real Weibull::rand() const
 #ifdef _OPENMP
 //#pragma omp critical
 #endif
+if (RandStream* p_stream = currentStream()) return p_stream->randWeibull(k_, lambda_);
 GetRNGstate(); Real s = Rf_rweibull(k_, lambda_); PutRNGstate(); return s;
 }
 
@@ -174,6 +175,7 @@ inline Real Weibull::rand( Real const& k, Real const& lambda)
 #ifdef _OPENMP
 //#pragma omp critical
 #endif
+if (RandStream* p_stream = currentStream()) return p_stream->randWeibull(k, lambda);
 GetRNGstate(); Real s = Rf_rweibull(k, lambda); PutRNGstate(); return s;
 }
 
@@ -36,6 +36,8 @@
 #ifndef STK_RANDBASE_H
 #define STK_RANDBASE_H
 
+#include "STK_RandStream.h"
+
 #ifdef IS_RTKPP_LIB /* is rtkpp lib */
 
 #include <R_ext/Random.h>
@@ -48,6 +50,8 @@ namespace STK
 {
 /** @ingroup Laws
  *  @brief class for the Base random generator.
+ *  If a RandStream is bound to the current thread, the random numbers are
+ *  drawn from this stream.
  **/
 class RandBase
 {
@@ -63,7 +67,8 @@ class RandBase
      *  @return a uniform number in (0,1) using the R random generator
     **/
     inline Real randUnif()
-    { GetRNGstate();
+    { if (RandStream* p_stream = Law::currentStream()) return p_stream->randUnif();
+      GetRNGstate();
       Real s = Rf_runif(0, 1);
       PutRNGstate();
       return s;
@@ -78,14 +83,16 @@ class RandBase
      * @return a real number from a normal (Gaussian) distribution.
     **/
     inline Real randGauss( Real const& mu = 0, Real const& sigma = 1)
-    { GetRNGstate();
+    { if (RandStream* p_stream = Law::currentStream()) return p_stream->randGauss(mu, sigma);
+      GetRNGstate();
       Real s = Rf_rnorm(mu, sigma);
       PutRNGstate();
       return s;
     }
     /** real number in (0,n) */
     inline Real rand( Real const& n )
-    { GetRNGstate();
+    { if (RandStream* p_stream = Law::currentStream()) return p_stream->rand(n);
+      GetRNGstate();
       Real s = Rf_runif(0, n);
       PutRNGstate();
       return s;
@@ -127,6 +134,11 @@ namespace STK
  *
  * For the exponential Law we remove the old method and use directly
  * the inverse pdf method.
+ *
+ * If a RandStream is bound to the current thread, the random numbers of all
+ * the public methods are drawn from this stream. The stream draws its
+ * uniform numbers in (0,1), so the bounds of rand() and randExc() are then
+ * never returned.
  **/
 class RandBase: protected MTRand
 {
@@ -189,7 +201,11 @@ class RandBase: protected MTRand
     *  Mersenne Twister method. This is a wrapper of the MTRand class.
     *  @sa STK::MTRand
     **/
-    inline int randDiscreteUnif() { return int(Real(randInt()));}
+    inline int randDiscreteUnif()
+    {
+      if (RandStream* p_stream = Law::currentStream()) return int(Real(p_stream->randInt()));
+      return int(Real(randInt()));
+    }
     /** pseudo-random uniform generator.
      *  This is a wrapper of the MTRand class.
      *  \f[
@@ -201,19 +217,47 @@ class RandBase: protected MTRand
     inline Real randUnif() { return Real(randDblExc());}
 
     /** @return same as randUnif().*/
-    inline Real operator()() { return (Real)MTRand::operator()(); }
+    inline Real operator()()
+    {
+      if (RandStream* p_stream = Law::currentStream()) return p_stream->randUnif();
+      return (Real)MTRand::operator()();
+    }
     /** real number in [0,1] */
-    inline Real rand() { return (Real)MTRand::rand(); }
+    inline Real rand()
+    {
+      if (RandStream* p_stream = Law::currentStream()) return p_stream->randUnif();
+      return (Real)MTRand::rand();
+    }
     /** real number in [0,n] */
-    inline Real rand( Real const& n ) { return (Real)MTRand::rand((double)n); }
+    inline Real rand( Real const& n )
+    {
+      if (RandStream* p_stream = Law::currentStream()) return p_stream->rand(n);
+      return (Real)MTRand::rand((double)n);
+    }
     /** real number in [0,1) */
-    inline Real randExc() { return (Real)MTRand::randExc(); }
+    inline Real randExc()
+    {
+      if (RandStream* p_stream = Law::currentStream()) return p_stream->randUnif();
+      return (Real)MTRand::randExc();
+    }
     /** real number in [0,n) */
-    inline Real randExc( Real const& n ) { return (Real)MTRand::randExc((double)n); }
+    inline Real randExc( Real const& n )
+    {
+      if (RandStream* p_stream = Law::currentStream()) return p_stream->rand(n);
+      return (Real)MTRand::randExc((double)n);
+    }
     /** real number in (0,1) */
-    inline Real randDblExc() { return (Real)MTRand::randDblExc(); }
+    inline Real randDblExc()
+    {
+      if (RandStream* p_stream = Law::currentStream()) return p_stream->randUnif();
+      return (Real)MTRand::randDblExc();
+    }
     /** real number in (0,n) */
-    inline Real randDblExc( Real const& n ) { return (Real)MTRand::randDblExc((double)n); }
+    inline Real randDblExc( Real const& n )
+    {
+      if (RandStream* p_stream = Law::currentStream()) return p_stream->rand(n);
+      return (Real)MTRand::randDblExc((double)n);
+    }
 
     /** Pseudo-random gaussian generator of the gaussian probability law:
      * \f[     f(x) = \frac{1}{\sqrt{2\pi}}
@@ -280,6 +324,7 @@ inline RandBase::~RandBase()
 **/
 inline Real RandBase::randGauss(Real const& mu, Real const& sigma)
 {
+  if (RandStream* p_stream = Law::currentStream()) return p_stream->randGauss(mu, sigma);
   while(1)
   {
     // uniforms number
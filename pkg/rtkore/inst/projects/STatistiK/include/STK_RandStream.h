@@ -0,0 +1,337 @@
+/*--------------------------------------------------------------------*/
+/*     Copyright (C) 2004-2016  Serge Iovleff, Université Lille 1, Inria
+
+    This program is free software; you can redistribute it and/or modify
+    it under the terms of the GNU Lesser General Public License as
+    published by the Free Software Foundation; either version 2 of the
+    License, or (at your option) any later version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU Lesser General Public License for more details.
+
+    You should have received a copy of the GNU Lesser General Public
+    License along with this program; if not, write to the
+    Free Software Foundation, Inc.,
+    59 Temple Place,
+    Suite 330,
+    Boston, MA 02111-1307
+    USA
+
+    Contact : S..._Dot_I..._At_stkpp_Dot_org (see copyright for ...)
+*/
+
+/* Project:  stkpp::STatistiK
+ * Purpose:  Counter based random streams.
+ * Author:   Serge Iovleff, S..._Dot_I..._At_stkpp_Dot_org (see copyright for ...)
+ **/
+
+/** @file STK_RandStream.h
+ *  @brief Declaration of the RandStream class.
+ *  The RandStream class furnish independent and reproducible streams of
+ *  pseudo random numbers which can be used concurrently by several threads.
+ **/
+
+#ifndef STK_RANDSTREAM_H
+#define STK_RANDSTREAM_H
+
+#include <stdint.h>
+#include <cmath>
+
+#include <STKernel.h>
+#include "Analysis/include/STK_Const_Math.h"
+#include "Analysis/include/STK_Const_Sequences.h"
+#include "Analysis/include/STK_Funct_gamma.h"
+
+namespace STK
+{
+/** @ingroup Laws
+ *  @brief Counter based pseudo random generator.
+ *
+ *  A RandStream is the Philox4x32-10 generator of
+ *  J. K. Salmon, M. A. Moraes, R. O. Dror and D. E. Shaw,
+ *  "Parallel Random Numbers: As Easy as 1, 2, 3", SC11 (2011).
+ *  The n-th block of random bits of a stream is a bijection of the counter
+ *  (n, stream) with the seed as key, so two streams with the same seed and
+ *  different ids are independent, and the numbers drawn by a task do not
+ *  depend on the thread executing it. The samplers use the same
+ *  parameterization as the R random generators.
+ *
+ *  A RandStream is not shared between threads: each task owns its stream.
+ *  @sa Law::StreamScope
+ **/
+class RandStream
+{
+  public:
+    /** constructor.
+     *  @param seed seed of the stream (the key of the generator)
+     *  @param stream id of the stream
+     **/
+    inline RandStream(uint64_t seed = 0, uint64_t stream = 0) { setSeed(seed, stream);}
+    /** set the seed and the id of the stream and reset the counter.
+     *  @param seed seed of the stream
+     *  @param stream id of the stream
+     **/
+    inline void setSeed(uint64_t seed, uint64_t stream = 0)
+    {
+      key_[0] = uint32_t(seed); key_[1] = uint32_t(seed >> 32);
+      ctr_[0] = 0; ctr_[1] = 0;
+      ctr_[2] = uint32_t(stream); ctr_[3] = uint32_t(stream >> 32);
+      index_ = 4;
+      hasGauss_ = false;
+    }
+    /** skip the @c n next blocks (4 x 32 bits) of the stream */
+    inline void skip(uint64_t n)
+    {
+      uint64_t c = ((uint64_t(ctr_[1]) << 32) | ctr_[0]) + n;
+      ctr_[0] = uint32_t(c); ctr_[1] = uint32_t(c >> 32);
+      index_ = 4;
+      hasGauss_ = false;
+    }
+    /** @return 32 random bits */
+    inline uint32_t randInt()
+    {
+      if (index_ == 4) { nextBlock();}
+      return block_[index_++];
+    }
+    /** @return a uniform number in (0,1) with 53 random bits */
+    inline Real randUnif()
+    {
+      uint32_t a = randInt() >> 5, b = randInt() >> 6;
+      return (a * 67108864.0 + b + 0.5) * (1.0/9007199254740992.0);
+    }
+    /** @return same as randUnif() */
+    inline Real operator()() { return randUnif();}
+    /** @return a uniform number in (a,b) */
+    inline Real randUnif(Real const& a, Real const& b) { return a + (b - a)*randUnif();}
+    /** @return a uniform number in (0,n) */
+    inline Real rand(Real const& n) { return n*randUnif();}
+    /** @return a gaussian number using the Box-Muller method
+     *  @param mu,sigma mean and standard deviation of the gaussian distribution
+     **/
+    Real randGauss(Real const& mu = 0, Real const& sigma = 1);
+    /** @return an exponential number with the given mean */
+    inline Real randExp(Real const& scale = 1) { return -scale * std::log(randUnif());}
+    /** @return a gamma number with the given shape and scale (Marsaglia and Tsang method) */
+    Real randGamma(Real const& shape, Real const& scale);
+    /** @return a beta number */
+    inline Real randBeta(Real const& alpha, Real const& beta)
+    {
+      Real x = randGamma(alpha, 1.), y = randGamma(beta, 1.);
+      return x/(x+y);
+    }
+    /** @return a chi-squared number with @c df degrees of freedom */
+    inline Real randChiSquared(Real const& df) { return randGamma(df/2., 2.);}
+    /** @return a Fisher-Snedecor number */
+    inline Real randFisherSnedecor(Real const& df1, Real const& df2)
+    { return (randChiSquared(df1)/df1)/(randChiSquared(df2)/df2);}
+    /** @return a Student number with @c df degrees of freedom */
+    inline Real randStudent(Real const& df)
+    { return randGauss()/std::sqrt(randChiSquared(df)/df);}
+    /** @return a Cauchy number */
+    inline Real randCauchy(Real const& mu, Real const& scale)
+    { return mu + scale * std::tan(Const::_PI_ * (randUnif() - 0.5));}
+    /** @return a logistic number */
+    inline Real randLogistic(Real const& mu, Real const& scale)
+    { Real u = randUnif(); return mu + scale * std::log(u/(1.-u));}
+    /** @return a log-normal number */
+    inline Real randLogNormal(Real const& mu, Real const& sigma)
+    { return std::exp(randGauss(mu, sigma));}
+    /** @return a Weibull number */
+    inline Real randWeibull(Real const& shape, Real const& scale)
+    { return scale * std::pow(-std::log(randUnif()), 1./shape);}
+    /** @return the number of failures before a success with probability @c prob */
+    inline int randGeometric(Real const& prob)
+    { return (prob == 1.) ? 0 : int(std::floor(std::log(randUnif())/std::log(1.-prob)));}
+    /** @return a Poisson number (inversion for small lambda, PTRS method otherwise) */
+    int randPoisson(Real const& lambda);
+    /** @return a binomial number (inversion for small n*p, BTRS method otherwise) */
+    int randBinomial(int n, Real const& prob);
+    /** @return a negative binomial number (Poisson-gamma mixture) */
+    inline int randNegativeBinomial(Real const& size, Real const& prob)
+    { return (prob == 1.) ? 0 : randPoisson(randGamma(size, (1.-prob)/prob));}
+    /** @return the number of successes in @c nbDraws draws without replacement */
+    int randHyperGeometric(int nbSuccesses, int nbFailures, int nbDraws);
+
+  private:
+    /** key of the generator */
+    uint32_t key_[2];
+    /** counter: number of the block and id of the stream */
+    uint32_t ctr_[4];
+    /** current block of random bits */
+    uint32_t block_[4];
+    /** index of the next random bits in the current block */
+    int index_;
+    /** @c true if a second gaussian number is available */
+    bool hasGauss_;
+    /** second gaussian number of the Box-Muller method */
+    Real gauss_;
+
+    /** compute the block of the current counter and increment the counter */
+    void nextBlock();
+    /** @return the log of the factorial of k */
+    static Real lfactorial(int k)
+    { return (k < 51) ? Const::factorialLnArray[k] : Funct::lgammaStirling(k + 1.);}
+};
+
+inline void RandStream::nextBlock()
+{
+  uint32_t c0 = ctr_[0], c1 = ctr_[1], c2 = ctr_[2], c3 = ctr_[3];
+  uint32_t k0 = key_[0], k1 = key_[1];
+  for (int r = 0; r < 10; ++r)
+  {
+    uint64_t p0 = uint64_t(0xD2511F53) * c0, p1 = uint64_t(0xCD9E8D57) * c2;
+    uint32_t hi0 = uint32_t(p0 >> 32), lo0 = uint32_t(p0);
+    uint32_t hi1 = uint32_t(p1 >> 32), lo1 = uint32_t(p1);
+    c0 = hi1 ^ c1 ^ k0; c1 = lo1;
+    c2 = hi0 ^ c3 ^ k1; c3 = lo0;
+    k0 += 0x9E3779B9; k1 += 0xBB67AE85;
+  }
+  block_[0] = c0; block_[1] = c1; block_[2] = c2; block_[3] = c3;
+  index_ = 0;
+  if (++ctr_[0] == 0) { ++ctr_[1];}
+}
+
+inline Real RandStream::randGauss(Real const& mu, Real const& sigma)
+{
+  if (hasGauss_) { hasGauss_ = false; return mu + sigma * gauss_;}
+  Real r = std::sqrt(-2. * std::log(randUnif())), theta = 2. * Const::_PI_ * randUnif();
+  gauss_ = r * std::sin(theta);
+  hasGauss_ = true;
+  return mu + sigma * r * std::cos(theta);
+}
+
+inline Real RandStream::randGamma(Real const& shape, Real const& scale)
+{
+  if (!(shape > 0.)) { return (shape == 0.) ? 0. : Arithmetic<Real>::NA();}
+  if (shape < 1.)
+  { // boost the shape and correct with a uniform
+    Real u = randUnif();
+    return randGamma(1. + shape, scale) * std::pow(u, 1./shape);
+  }
+  const Real d = shape - 1./3., c = 1./std::sqrt(9.*d);
+  for (;;)
+  {
+    Real x, v;
+    do { x = randGauss(); v = 1. + c * x;} while (v <= 0.);
+    v = v * v * v;
+    Real u = randUnif();
+    if (u < 1. - 0.0331 * (x*x) * (x*x)) return scale * d * v;
+    if (std::log(u) < 0.5 * x * x + d * (1. - v + std::log(v))) return scale * d * v;
+  }
+}
+
+inline int RandStream::randPoisson(Real const& lambda)
+{
+  if (!(lambda > 0.)) { return 0;}
+  if (lambda < 30.)
+  { // inversion
+    Real p = std::exp(-lambda), s = p, u = randUnif();
+    int k = 0;
+    while (u > s && p > 0.) { ++k; p *= lambda/k; s += p;}
+    return k;
+  }
+  // PTRS method of W. Hormann (1993)
+  const Real slam = std::sqrt(lambda), loglam = std::log(lambda);
+  const Real b = 0.931 + 2.53 * slam, a = -0.059 + 0.02483 * b;
+  const Real invalpha = 1.1239 + 1.1328/(b - 3.4), vr = 0.9277 - 3.6224/(b - 2.);
+  for (;;)
+  {
+    Real u = randUnif() - 0.5, v = randUnif(), us = 0.5 - std::abs(u);
+    Real k = std::floor((2. * a/us + b) * u + lambda + 0.43);
+    if (us >= 0.07 && v <= vr) return int(k);
+    if (k < 0. || (us < 0.013 && v > us)) continue;
+    if ( std::log(v) + std::log(invalpha) - std::log(a/(us*us) + b)
+         <= -lambda + k * loglam - lfactorial(int(k)))
+      return int(k);
+  }
+}
+
+inline int RandStream::randBinomial(int n, Real const& prob)
+{
+  if (n <= 0 || !(prob > 0.)) return 0;
+  if (prob >= 1.) return n;
+  if (prob > 0.5) return n - randBinomial(n, 1. - prob);
+  const Real q = 1. - prob;
+  if (n * prob < 30.)
+  { // inversion
+    const Real s = prob/q, a = (n + 1) * s;
+    Real r = std::pow(q, n), u = randUnif();
+    int k = 0;
+    while (u > r && k < n) { u -= r; ++k; r *= (a/k - s);}
+    return k;
+  }
+  // BTRS method of W. Hormann (1993)
+  const Real spq = std::sqrt(n * prob * q);
+  const Real b = 1.15 + 2.53 * spq, a = -0.0873 + 0.0248 * b + 0.01 * prob;
+  const Real c = n * prob + 0.5, vr = 0.92 - 4.2/b, alpha = (2.83 + 5.1/b) * spq;
+  const Real lpq = std::log(prob/q);
+  const int m = int(std::floor((n + 1) * prob));
+  const Real h = lfactorial(m) + lfactorial(n - m);
+  for (;;)
+  {
+    Real u = randUnif() - 0.5, v = randUnif(), us = 0.5 - std::abs(u);
+    Real k = std::floor((2. * a/us + b) * u + c);
+    if (k < 0. || k > n) continue;
+    if (us >= 0.07 && v <= vr) return int(k);
+    v = std::log(v * alpha/(a/(us*us) + b));
+    if (v <= h - lfactorial(int(k)) - lfactorial(n - int(k)) + (k - m) * lpq) return int(k);
+  }
+}
+
+inline int RandStream::randHyperGeometric(int nbSuccesses, int nbFailures, int nbDraws)
+{
+  int k = 0;
+  for (int i = 0; i < nbDraws && nbSuccesses > 0; ++i)
+  {
+    if (randUnif() * (nbSuccesses + nbFailures) < nbSuccesses) { ++k; --nbSuccesses;}
+    else { --nbFailures;}
+  }
+  return k;
+}
+
+namespace Law
+{
+/** @ingroup Laws
+ *  @return a reference on the pointer of the RandStream bound to the current
+ *  thread, the pointer is 0 if the thread use the default generator.
+ **/
+inline RandStream*& currentStream()
+{
+  static thread_local RandStream* p_stream = 0;
+  return p_stream;
+}
+
+/** @ingroup Laws
+ *  @brief Bind a RandStream to the current thread during the life of the
+ *  object. While the stream is bound, the random numbers of the Law::generator
+ *  and of the laws are drawn from the stream, e.g.
+ *  @code
+ *    RandStream stream(seed, task);
+ *    Law::StreamScope scope(stream);
+ *    x.rand(Law::Normal(0,1)); // use the stream
+ *  @endcode
+ **/
+class StreamScope
+{
+  public:
+    /** bind @c stream to the current thread */
+    inline explicit StreamScope(RandStream& stream): p_previous_(currentStream())
+    { currentStream() = &stream;}
+    /** restore the previous stream of the thread */
+    inline ~StreamScope() { currentStream() = p_previous_;}
+
+  private:
+    /** stream bound before this scope */
+    RandStream* p_previous_;
+    /** forbidden copies */
+    StreamScope(StreamScope const&);
+    StreamScope& operator=(StreamScope const&);
+};
+
+} // namespace Law
+
+} // namespace STK
+
+#endif // STK_RANDSTREAM_H
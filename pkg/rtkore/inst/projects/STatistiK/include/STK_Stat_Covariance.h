@@ -35,10 +35,239 @@
 #ifndef STK_STAT_COVARIANCE_H
 #define STK_STAT_COVARIANCE_H
 
+#include <vector>
 #include "STK_Stat_Functors.h"
 
+#ifdef STKUSELAPACK
+#include <Algebra/include/STK_lapack_Util.h>
+#endif
+
 namespace STK
 {
+namespace hidden
+{
+/** @ingroup hidden
+ *  @brief Compute the cross-product matrix @c x^T x of a data set stored in a
+ *  column oriented CArrayXX with ranges starting at 0.
+ *
+ *  If STKUSELAPACK is defined, the BLAS routine syrk is used. Otherwise the
+ *  upper part of the product is computed by tiles of columns and panels of
+ *  rows. When there are enough tiles, the tiles are computed in parallel,
+ *  otherwise the rows are split in a fixed number of chunks computed in
+ *  parallel and summed in the order of the chunks. In both cases the result
+ *  does not depend on the number of threads.
+ **/
+struct CrossProduct
+{
+  enum
+  {
+    /** size of the tiles of columns */
+    tileSize_ = 64,
+    /** number of rows of the panels */
+    panelSize_ = 256,
+    /** minimal number of rows of a chunk */
+    chunkSize_ = 4096,
+    /** maximal number of chunks */
+    maxChunk_ = 16
+  };
+
+  /** compute the symmetric matrix @c xtx = x^T x
+   *  @param x the data set
+   *  @param xtx the result
+   **/
+  static void run(CArrayXX const& x, CArrayXX& xtx)
+  {
+    const int n = x.sizeRows(), d = x.sizeCols();
+    xtx.resize(d, d);
+    xtx = 0.;
+    if (n == 0 || d == 0) return;
+#ifdef STKUSELAPACK
+    lapack::syrk('U', 'T', d, n, 1., x.p_data(), n, 0., xtx.p_data(), d);
+#else
+    const int nbTile = (d + tileSize_ - 1)/tileSize_, nbPair = nbTile*(nbTile+1)/2;
+    const int nbChunk = std::min(int(maxChunk_), std::max(1, n/chunkSize_));
+    if (nbPair >= int(maxChunk_) || nbChunk == 1)
+    {
+      int p;
+#ifdef _OPENMP
+#pragma omp parallel for schedule(dynamic) if (nbPair > 1)
+#endif
+      for (p = 0; p < nbPair; ++p)
+      { updatePair(x, 0, n, p, xtx.p_data());}
+    }
+    else
+    {
+      std::vector<CArrayXX> partial(nbChunk);
+      int c;
+#ifdef _OPENMP
+#pragma omp parallel for schedule(dynamic)
+#endif
+      for (c = 0; c < nbChunk; ++c)
+      {
+        partial[c].resize(d, d);
+        partial[c] = 0.;
+        const int first = int((double(n)*c)/nbChunk), last = int((double(n)*(c+1))/nbChunk);
+        for (int p = 0; p < nbPair; ++p)
+        { updatePair(x, first, last, p, partial[c].p_data());}
+      }
+      for (c = 0; c < nbChunk; ++c) { xtx += partial[c];}
+    }
+#endif
+    // copy the upper part in the lower part
+    for (int j = 1; j < d; ++j)
+    { for (int i = 0; i < j; ++i) { xtx(j, i) = xtx(i, j);}}
+  }
+  /** add the product of the rows [first, last) of the columns of the p-th
+   *  pair of tiles (ti <= tj) to the upper part of c (of size d) */
+  static void updatePair(CArrayXX const& x, int first, int last, int p, Real* c)
+  {
+    // find the pair of tiles, p = tj(tj+1)/2 + ti
+    int tj = 0;
+    while ((tj+1)*(tj+2)/2 <= p) { ++tj;}
+    const int ti = p - tj*(tj+1)/2, d = x.sizeCols(), ld = x.sizeRows();
+    const int iBegin = ti*tileSize_, iEnd = std::min(d, iBegin + tileSize_);
+    const int jBegin = tj*tileSize_, jEnd = std::min(d, jBegin + tileSize_);
+    Real const* p_x = x.p_data();
+    for (int r = first; r < last; r += panelSize_)
+    {
+      const int rEnd = std::min(last, r + panelSize_);
+      for (int j = jBegin; j < jEnd; ++j)
+      {
+        Real const* xj = p_x + size_t(j)*ld;
+        const int iLast = std::min(iEnd, j+1);
+        for (int i = iBegin; i < iLast; ++i)
+        { c[size_t(j)*d + i] += dot(p_x + size_t(i)*ld, xj, r, rEnd);}
+      }
+    }
+  }
+  /** @return the dot product of x and y in [first, last) */
+  static inline Real dot(Real const* x, Real const* y, int first, int last)
+  {
+    Real s0 = 0., s1 = 0., s2 = 0., s3 = 0.;
+    int r = first;
+    for (; r + 3 < last; r += 4)
+    { s0 += x[r]*y[r]; s1 += x[r+1]*y[r+1]; s2 += x[r+2]*y[r+2]; s3 += x[r+3]*y[r+3];}
+    for (; r < last; ++r) { s0 += x[r]*y[r];}
+    return (s0 + s1) + (s2 + s3);
+  }
+};
+
+/** @ingroup hidden
+ *  Copy the columns (or the rows if byRow is true) of V centered by mean in
+ *  the columns of x and compute the sum of the deviations.
+ *  @param V the data set
+ *  @param mean the mean of the variables
+ *  @param byRow @c true if the variables are the rows of V
+ *  @param x the centered data set
+ *  @param sum the sums of the deviations
+ **/
+template<class Array, class Mean>
+void centerData( ExprBase<Array> const& V, Mean const& mean, bool byRow
+               , CArrayXX& x, CPointX& sum)
+{
+  const int d = byRow ? V.sizeRows() : V.sizeCols();
+  x.resize(byRow ? V.sizeCols() : V.sizeRows(), d);
+  sum.resize(d);
+  sum = 0.;
+  for (int j = V.beginCols(), jx = 0; j < V.endCols(); ++j, ++jx)
+  {
+    for (int i = V.beginRows(), ix = 0; i < V.endRows(); ++i, ++ix)
+    {
+      if (byRow) { sum[ix] += (x(jx, ix) = V.elt(i, j) - mean[i]);}
+      else       { sum[jx] += (x(ix, jx) = V.elt(i, j) - mean[j]);}
+    }
+  }
+}
+
+/** @ingroup hidden
+ *  Copy the columns (or the rows if byRow is true) of V centered by mean and
+ *  scaled by the square root of the absolute value of the weights in the
+ *  columns of x.
+ *  @param V,W the data set and the weights
+ *  @param mean the weighted mean of the variables
+ *  @param byRow @c true if the variables are the rows of V
+ *  @param x the centered and scaled data set
+ *  @param sumWeights,sum2Weights the sum of the (absolute) weights and of
+ *  their squared values
+ **/
+template<class Array, class Weights, class Mean>
+void centerData( ExprBase<Array> const& V, Weights const& W, Mean const& mean, bool byRow
+               , CArrayXX& x, Real& sumWeights, Real& sum2Weights)
+{
+  const int d = byRow ? V.sizeRows() : V.sizeCols();
+  x.resize(byRow ? V.sizeCols() : V.sizeRows(), d);
+  sumWeights = 0.; sum2Weights = 0.;
+  for (int l = W.begin(); l < W.end(); ++l)
+  {
+    Real w = std::abs((Real)W[l]);
+    sumWeights += w; sum2Weights += w*w;
+  }
+  for (int j = V.beginCols(), jx = 0; j < V.endCols(); ++j, ++jx)
+  {
+    for (int i = V.beginRows(), ix = 0; i < V.endRows(); ++i, ++ix)
+    {
+      if (byRow) { x(jx, ix) = std::sqrt(std::abs((Real)W[j])) * (V.elt(i, j) - mean[i]);}
+      else       { x(ix, jx) = std::sqrt(std::abs((Real)W[i])) * (V.elt(i, j) - mean[j]);}
+    }
+  }
+}
+
+/** @ingroup hidden
+ *  Compute the covariance matrix of the centered data set x.
+ *  \f[ \hat{\Sigma} = \frac{1}{n} (x^T x - \frac{1}{n} s s^T), \f]
+ *  where @e s is the sum of the deviations, using the fast cross product.
+ *  @param x,sum the centered data set and the sums of the deviations
+ *  @param unbiased @c true if we want an unbiased estimate
+ *  @param cov the covariance matrix
+ **/
+template<class Square>
+void covarianceFromCentered(CArrayXX const& x, CPointX const& sum, bool unbiased, Square& cov)
+{
+  const int n = x.sizeRows(), d = x.sizeCols();
+  CArrayXX xtx;
+  CrossProduct::run(x, xtx);
+  const Real den = unbiased ? Real(n - 1) : Real(n);
+  const bool ok = unbiased ? (n > 1) : (n > 0);
+  for (int j = 0, jc = cov.beginCols(); j < d; ++j, ++jc)
+  {
+    for (int i = 0, ic = cov.beginRows(); i < d; ++i, ++ic)
+    {
+      cov(ic, jc) = ok ? (xtx(i, j) - sum[i]*sum[j]/Real(n))/den
+                       : (unbiased ? Arithmetic<Real>::infinity() : 0.);
+    }
+  }
+}
+
+/** @ingroup hidden
+ *  Compute the weighted covariance matrix of the centered and scaled data
+ *  set x.
+ *  @param x the centered and scaled data set
+ *  @param sumWeights,sum2Weights the sum of the (absolute) weights and of
+ *  their squared values
+ *  @param unbiased @c true if we want an unbiased estimate
+ *  @param cov the covariance matrix
+ **/
+template<class Square>
+void covarianceFromCentered( CArrayXX const& x, Real sumWeights, Real sum2Weights
+                           , bool unbiased, Square& cov)
+{
+  const int d = x.sizeCols();
+  CArrayXX xtx;
+  CrossProduct::run(x, xtx);
+  // as in the scalar versions, the covariance is zero if the denominator is
+  // not positive (no weight, or a single non zero weight if unbiased)
+  const bool ok = unbiased ? (sumWeights*sumWeights > sum2Weights) : (sumWeights > 0.);
+  const Real den = !ok ? 0.
+                 : (unbiased ? sumWeights - sum2Weights/sumWeights : sumWeights);
+  for (int j = 0, jc = cov.beginCols(); j < d; ++j, ++jc)
+  {
+    for (int i = 0, ic = cov.beginRows(); i < d; ++i, ++ic)
+    { cov(ic, jc) = (ok && den > 0.) ? xtx(i, j)/den : 0.;}
+  }
+}
+
+} // namespace hidden
+
 namespace Stat
 {
 
@@ -475,6 +704,8 @@ Real covarianceWithFixedMeanSafe( ExprBase<XArray> const& X
  *  \f[ \hat{\Sigma} = \frac{1}{n}
  *                       \sum_{i=1}^n (V_i-\hat{\mu}) (V_i-\hat{\mu})^T.
  *  \f]
+ *  The data set is centered once and the matrix is computed using a single
+ *  blocked rank-k update (see hidden::CrossProduct).
  *  @param V variable
  *  @param unbiased @c true if we want an unbiased estimate of the variance,
  *  @c false otherwise (default is @c false)
@@ -488,12 +719,10 @@ covariance( ExprBase<Array> const& V, bool unbiased = false)
   typename hidden::FunctorTraits<Array, MeanOp>::Row mean;
   // compute the mean
   mean.move(Stat::mean(V.asDerived()));
-  for (int j= cov_.begin(); j< cov_.end(); j++)
-  {
-    cov_(j, j) = varianceWithFixedMean(V.col(j), mean[j], unbiased);
-    for (int i= cov_.begin(); i<j; i++)
-    { cov_(j,i) = ( cov_(i, j) = covarianceWithFixedMean(V.col(i), V.col(j), mean[i], mean[j], unbiased));}
-  }
+  CArrayXX x;
+  CPointX sum;
+  hidden::centerData(V, mean, false, x, sum);
+  hidden::covarianceFromCentered(x, sum, unbiased, cov_);
   return cov_;
 }
 
@@ -514,12 +743,10 @@ covarianceByRow( ExprBase<Array> const& V, bool unbiased = false)
   typename hidden::FunctorTraits<Array, MeanOp>::Col mean;
   // compute the mean
   mean.move(Stat::meanByRow(V.asDerived()));
-  for (int j= cov_.begin(); j< cov_.end(); j++)
-  {
-    cov_(j, j) = varianceWithFixedMean(V.row(j), mean[j], unbiased);
-    for (int i= cov_.begin(); i<j; i++)
-    { cov_(j,i) = ( cov_(i, j) = covarianceWithFixedMean(V.row(i), V.row(j), mean[i], mean[j], unbiased));}
-  }
+  CArrayXX x;
+  CPointX sum;
+  hidden::centerData(V, mean, true, x, sum);
+  hidden::covarianceFromCentered(x, sum, unbiased, cov_);
   return cov_;
 }
 
@@ -540,12 +767,10 @@ covariance( ExprBase<Array> const& V, Weights const& W, bool unbiased = false)
   typename hidden::FunctorTraits<Array, MeanOp>::Row mean;
   // compute the mean
   mean.move(Stat::mean(V.asDerived(), W.asDerived()));
-  for (int j= cov_.begin(); j< cov_.end(); j++)
-  {
-    cov_(j, j) = varianceWithFixedMean(V.col(j), W, mean[j], unbiased);
-    for (int i= cov_.begin(); i<j; i++)
-    { cov_(j,i) = ( cov_(i, j) = covarianceWithFixedMean(V.col(i), V.col(j), W, mean[i], mean[j], unbiased));}
-  }
+  CArrayXX x;
+  Real sumWeights, sum2Weights;
+  hidden::centerData(V, W, mean, false, x, sumWeights, sum2Weights);
+  hidden::covarianceFromCentered(x, sumWeights, sum2Weights, unbiased, cov_);
   return cov_;
 }
 
@@ -565,12 +790,10 @@ covarianceByRow( ExprBase<Array> const& V, Weights const& W, bool unbiased = fal
   CArraySquare<typename Array::Type, Array::sizeRows_> cov_(V.rows());
   typename hidden::FunctorTraits<Array, MeanOp>::Col mean;
   mean.move(Stat::meanByRow(V.asDerived(), W.asDerived()));
-  for (int j= cov_.begin(); j< cov_.end(); j++)
-  {
-    cov_(j, j) = varianceWithFixedMean(V.row(j), W, mean[j], unbiased);
-    for (int i= cov_.begin(); i<j; i++)
-    { cov_(j,i) = ( cov_(i, j) = covarianceWithFixedMean(V.row(i), V.row(j), W, mean[i], mean[j], unbiased));}
-  }
+  CArrayXX x;
+  Real sumWeights, sum2Weights;
+  hidden::centerData(V, W, mean, true, x, sumWeights, sum2Weights);
+  hidden::covarianceFromCentered(x, sumWeights, sum2Weights, unbiased, cov_);
   return cov_;
 }
 
@@ -592,12 +815,10 @@ covarianceWithFixedMean( ExprBase<Array> const& V, ExprBase<Mean> const& mean, b
   if (V.cols()!=mean.range()) STKRUNTIME_ERROR_NO_ARG(covarianceWithFixedMean,V.cols()!=mean.range());
 #endif
   CArraySquare<typename Array::Type, Array::sizeCols_> cov_(V.cols());
-  for (int j= cov_.begin(); j< cov_.end(); j++)
-  {
-    cov_(j, j) = varianceWithFixedMean(V.col(j), mean[j], unbiased);
-    for (int i= cov_.begin(); i<j; i++)
-    { cov_(j,i) = ( cov_(i, j) = covarianceWithFixedMean(V.col(i), V.col(j), mean[i], mean[j], unbiased));}
-  }
+  CArrayXX x;
+  CPointX sum;
+  hidden::centerData(V, mean, false, x, sum);
+  hidden::covarianceFromCentered(x, sum, unbiased, cov_);
   return cov_;
 }
 
@@ -619,12 +840,10 @@ covarianceWithFixedMeanByRow( ExprBase<Array> const& V, ExprBase<Mean> const& me
   if (V.rows()!=mean.range()) STKRUNTIME_ERROR_NO_ARG(covarianceWithFixedMean,V.rows()!=mean.range());
 #endif
   CArraySquare<typename Array::Type, Array::sizeRows_> cov_(V.rows());
-  for (int j= cov_.begin(); j< cov_.end(); j++)
-  {
-    cov_(j, j) = varianceWithFixedMean(V.row(j), mean[j], unbiased);
-    for (int i= cov_.begin(); i<j; i++)
-    { cov_(j,i) = ( cov_(i, j) = covarianceWithFixedMean(V.row(i), V.row(j), mean[i], mean[j], unbiased));}
-  }
+  CArrayXX x;
+  CPointX sum;
+  hidden::centerData(V, mean, true, x, sum);
+  hidden::covarianceFromCentered(x, sum, unbiased, cov_);
   return cov_;
 }
 
@@ -644,16 +863,14 @@ covarianceWithFixedMean(  ExprBase<Array> const& V, Weights const& W, ExprBase<M
 {
 #ifdef STK_BOUNDS_CHECK
   if (V.cols()!=mean.range()) STKRUNTIME_ERROR_NO_ARG(covarianceWithFixedMean,V.cols()!=mean.range());
-  if (W.range()!=mean.range()) STKRUNTIME_ERROR_NO_ARG(covarianceWithFixedMean,W.range()!=mean.range());
+  if (W.range()!=V.rows()) STKRUNTIME_ERROR_NO_ARG(covarianceWithFixedMean,W.range()!=V.rows());
 #endif
 
   CArraySquare<typename Array::Type, Array::sizeCols_> cov_(V.cols());
-  for (int j= cov_.begin(); j< cov_.end(); j++)
-  {
-    cov_(j, j) = varianceWithFixedMean(V.col(j), W, mean[j], unbiased);
-    for (int i= cov_.begin(); i<j; i++)
-    { cov_(j,i) = ( cov_(i, j) = covarianceWithFixedMean(V.col(i), V.col(j), W, mean[i], mean[j], unbiased));}
-  }
+  CArrayXX x;
+  Real sumWeights, sum2Weights;
+  hidden::centerData(V, W, mean, false, x, sumWeights, sum2Weights);
+  hidden::covarianceFromCentered(x, sumWeights, sum2Weights, unbiased, cov_);
   return cov_;
 }
 
@@ -672,17 +889,15 @@ CArraySquare<typename Array::Type, Array::sizeRows_>
 covarianceWithFixedMeanByRow(  ExprBase<Array> const& V, Weights const& W, ExprBase<Mean> const& mean, bool unbiased = false)
 {
 #ifdef STK_BOUNDS_CHECK
-  if (V.rows()!=mean.range()) STKRUNTIME_ERROR_NO_ARG(covarianceWithFixedMean,V.cols()!=mean.range());
-  if (W.range()!=mean.range()) STKRUNTIME_ERROR_NO_ARG(covarianceWithFixedMean,W.range()!=mean.range());
+  if (V.rows()!=mean.range()) STKRUNTIME_ERROR_NO_ARG(covarianceWithFixedMeanByRow,V.rows()!=mean.range());
+  if (W.range()!=V.cols()) STKRUNTIME_ERROR_NO_ARG(covarianceWithFixedMeanByRow,W.range()!=V.cols());
 #endif
 
   CArraySquare<typename Array::Type, Array::sizeRows_> cov_(V.rows());
-  for (int j= cov_.begin(); j< cov_.end(); j++)
-  {
-    cov_(j, j) = varianceWithFixedMean(V.row(j), W, mean[j], unbiased);
-    for (int i= cov_.begin(); i<j; i++)
-    { cov_(j,i) = ( cov_(i, j) = covarianceWithFixedMean(V.row(i), V.row(j), W, mean[i], mean[j], unbiased));}
-  }
+  CArrayXX x;
+  Real sumWeights, sum2Weights;
+  hidden::centerData(V, W, mean, true, x, sumWeights, sum2Weights);
+  hidden::covarianceFromCentered(x, sumWeights, sum2Weights, unbiased, cov_);
   return cov_;
 }
 
@@ -133,16 +133,7 @@ class Multivariate<Array, Real>: public IRunnerUnsupervised< Array, typename hid
         max_.move(Stat::max(*this->p_data_));
         var_.move(varianceWithFixedMean(*this->p_data_, mean_, false));
 
-        cov_.resize(this->p_data_->cols());
-        for (int j=this->p_data_->beginCols(); j<this->p_data_->endCols(); j++)
-        {
-          cov_(j, j) = var_[j];
-          for (int i=this->p_data_->beginCols(); i<j; i++)
-          {
-            cov_(i, j) = covarianceWithFixedMean(this->p_data_->col(i), this->p_data_->col(j), mean_[i], mean_[j], false);
-            cov_(j, i) = cov_(i, j);
-          }
-        }
+        cov_ = covarianceWithFixedMean(*this->p_data_, mean_, false);
       }
       catch (Exception const& error)
       {
@@ -173,18 +164,7 @@ class Multivariate<Array, Real>: public IRunnerUnsupervised< Array, typename hid
         max_.move(Stat::max(*this->p_data_, weights));
         var_.move(varianceWithFixedMean(*this->p_data_, weights, mean_, false));
 
-        cov_.resize(this->p_data_->cols());
-        // for each variables
-        for (int j= this->p_data_->beginCols(); j< this->p_data_->endCols(); j++)
-        {
-          cov_(j, j) = var_[j];
-          // compute the covariances
-          for (int i= this->p_data_->beginCols(); i<j; i++)
-          {
-            cov_(i, j) = covarianceWithFixedMean(this->p_data_->col(i), this->p_data_->col(j), weights, mean_[i], mean_[j]);
-            cov_(j, i) = cov_(i, j);
-          }
-        }
+        cov_ = covarianceWithFixedMean(*this->p_data_, weights, mean_, false);
       }
       catch (Exception const& error)
       {
@@ -0,0 +1,58 @@
+#include "STKpp.h"
+using namespace STK;
+
+/* product with the block by panel kernels (previous implementation) */
+template<class Lhs, class Rhs>
+void blockProduct(Lhs const& lhs, Rhs const& rhs, CArrayXX& res)
+{
+  res.resize(lhs.rows(), rhs.cols()) = 0.;
+  (lhs.sizeRows()<rhs.sizeCols())
+  ? hidden::BlockByPanel<Lhs, Rhs, CArrayXX>::run(lhs, rhs, res)
+  : hidden::PanelByBlock<Lhs, Rhs, CArrayXX>::run(lhs, rhs, res);
+}
+/* product with the packed micro-kernels */
+template<class Lhs, class Rhs>
+void packedProduct(Lhs const& lhs, Rhs const& rhs, CArrayXX& res)
+{
+  res.resize(lhs.rows(), rhs.cols()) = 0.;
+  hidden::PackedProduct<Lhs, Rhs, CArrayXX>::run(lhs, rhs, res);
+}
+/* run the two products and display the Gflops and the maximal difference */
+void bench(int m, int k, int n, int nbRep)
+{
+  CArrayXX a(m, k), b(k, n), c1, c2;
+  a.randUnif(); b.randUnif();
+  Chrono::start();
+  for (int r=0; r<nbRep; ++r) { blockProduct(a, b, c1);}
+  Real t1 = Chrono::elapsed()/nbRep;
+  Chrono::start();
+  for (int r=0; r<nbRep; ++r) { packedProduct(a, b, c2);}
+  Real t2 = Chrono::elapsed()/nbRep;
+  Real flops = 2.*Real(m)*Real(n)*Real(k)*1e-9;
+  stk_cout << m << "x" << k << " * " << k << "x" << n
+           << "\tblock: " << flops/t1 << " Gflops"
+           << "\tpacked: " << flops/t2 << " Gflops"
+           << "\tspeedup: " << t1/t2
+           << "\tdiff: " << (c1-c2).abs().maxElt() << _T("\n");
+}
+
+/** @ingroup tutorial */
+int main(int argc, char** argv)
+{
+  ProductBlocking<Real> const& blocking = ProductBlocking<Real>::instance();
+  stk_cout << "micro-kernel: " << int(hidden::MicroKernel<Real>::mr_)
+           << "x" << int(hidden::MicroKernel<Real>::nr_)
+           << ", kc=" << blocking.kc_ << ", mc=" << blocking.mc_
+           << ", nc=" << blocking.nc_ << _T("\n");
+  stk_cout << "square products\n";
+  bench(128, 128, 128, 50);
+  bench(256, 256, 256, 10);
+  bench(512, 512, 512, 2);
+  bench(1024, 1024, 1024, 1);
+  stk_cout << "tall-skinny products\n";
+  bench(100000, 16, 16, 5);
+  bench(100000, 64, 64, 2);
+  bench(64, 100000, 64, 2);
+  bench(20000, 200, 10, 5);
+  return 0;
+}